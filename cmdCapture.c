@@ -0,0 +1,268 @@
+/*************************************************************************************************
+ * cmdCapture.c
+ * - C implementation or source file for recording command sessions and replaying them.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "cmdCapture.h"
+#include "nok5110LCD.h"
+#include "events.h"
+#include "timerB0.h"
+#include "usciUart.h"
+
+// ring of records. free running indexes, masked on access
+static unsigned char capBuf[CAPTURE_BUF_SZ];
+static unsigned int capHead = 0;
+static unsigned int capTail = 0;
+
+static unsigned char capOn = 0;
+static unsigned char capFirst = 1;          // next record is the first of the session
+static unsigned long capLast;               // timestamp of the previous record
+static unsigned int capLines = 0;
+static unsigned int capDropped = 0;
+
+//-- drops the oldest record
+static void cmdCaptureDropOldest(void){
+    capTail += CAPTURE_HDR + capBuf[(capTail + 2) & CAPTURE_BUF_MASK];
+    capLines--;
+    capDropped++;
+}
+
+//-- reads the record at index i into line. returns the index of the next record
+static unsigned int cmdCaptureRead(unsigned int i, unsigned int* dt, char* line){
+    unsigned char len, k;
+
+    *dt = capBuf[i & CAPTURE_BUF_MASK] | (capBuf[(i + 1) & CAPTURE_BUF_MASK] << 8);
+    len = capBuf[(i + 2) & CAPTURE_BUF_MASK];
+    i += CAPTURE_HDR;
+    for (k = 0; k < len; k++)
+        line[k] = capBuf[(i + k) & CAPTURE_BUF_MASK];
+    line[len] = NULL_CHAR;
+    return i + len;
+}
+
+//-- LPM0 until timerB0Now() reaches due. one alarm reaches 0xFFFF ticks, long gaps take several
+static void cmdCaptureSleepUntil(unsigned long due){
+    unsigned long left;
+
+    for (;;){
+        left = due - timerB0Now();
+        if ((long)left < TIMERB0_ALARM_MIN)     // due, or already late
+            break;
+        timerB0AlarmIn(left > 0xFFFF ? 0xFFFF : (unsigned int)left);
+        eventWait(EVT_ALARM);
+    }
+}
+
+/************************************************************************************
+* Function: cmdCaptureStart
+* - starts recording accepted command lines. the first one gets dt 0
+* argument: none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void cmdCaptureStart(void){
+    capFirst = 1;
+    capOn = 1;
+}
+
+/************************************************************************************
+* Function: cmdCaptureStop
+* - stops recording. the ring keeps what was captured
+* argument: none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void cmdCaptureStop(void){
+    capOn = 0;
+}
+
+/************************************************************************************
+* Function: cmdCaptureClear
+* - empties the ring and clears the dropped count
+* argument: none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void cmdCaptureClear(void){
+    capHead = capTail = 0;
+    capLines = capDropped = 0;
+    capFirst = 1;
+}
+
+/************************************************************************************
+* Function: cmdCaptureActive
+* - tells the parse stage whether to keep a copy of the raw line
+* argument: none
+* return: 1 while recording, else 0
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned char cmdCaptureActive(void){
+    return capOn;
+}
+
+/************************************************************************************
+* Function: cmdCaptureLine
+* - records one accepted command line with the ms since the previous one. does nothing
+*   when capture is off, or for the capture and replay commands
+* arguments:
+*   cmdIndex - index parseCmd returned for the line
+*   line - the line as received, before parseCmd split it
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void cmdCaptureLine(int cmdIndex, const char* line){
+    unsigned long now = timerB0Now();
+    unsigned long dt = 0;
+    unsigned int len = strlen(line);
+    unsigned int k;
+
+    if (!capOn || cmdIndex == CAPTURE_IDX || cmdIndex == REPLAY_IDX)
+        return;
+    if (len > BUFF_SZ - 1)
+        len = BUFF_SZ - 1;
+
+    if (!capFirst){
+        dt = timerB0TicksToUs(now - capLast) / 1000;
+        if (dt > 0xFFFF)
+            dt = 0xFFFF;
+    }
+    capFirst = 0;
+    capLast = now;
+
+    while (CAPTURE_BUF_SZ - (unsigned int)(capHead - capTail) < CAPTURE_HDR + len)
+        cmdCaptureDropOldest();
+
+    capBuf[capHead++ & CAPTURE_BUF_MASK] = dt & 0xFF;
+    capBuf[capHead++ & CAPTURE_BUF_MASK] = dt >> 8;
+    capBuf[capHead++ & CAPTURE_BUF_MASK] = len;
+    for (k = 0; k < len; k++)
+        capBuf[capHead++ & CAPTURE_BUF_MASK] = line[k];
+    capLines++;
+}
+
+/************************************************************************************
+* Function: cmdCaptureReport
+* - prints whether capture is on, lines and bytes held, and lines dropped over UART A1
+* argument: none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void cmdCaptureReport(void){
+    char line[80];
+
+    sprintf(line, "capture %s: %u lines %u/%u bytes, %u dropped\r\n", capOn ? "on" : "off",
+            capLines, capHead - capTail, CAPTURE_BUF_SZ, capDropped);
+    usciA1UartTxString(line);
+}
+
+/************************************************************************************
+* Function: cmdCaptureDump
+* - sends the ring oldest first in the dump format (see cmdCapture.h) over UART A1
+* argument: none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void cmdCaptureDump(void){
+    char line[BUFF_SZ];
+    char num[16];
+    unsigned int i = capTail;
+    unsigned int dt;
+
+    sprintf(num, "@CAP %u\r\n", capLines);
+    usciA1UartTxString(num);
+    while (i != capHead){
+        i = cmdCaptureRead(i, &dt, line);
+        sprintf(num, "%u ", dt);
+        usciA1UartTxString(num);
+        usciA1UartTxString(line);
+        usciA1UartTxString("\r\n");
+    }
+    sprintf(num, "@END %u\r\n", capDropped);
+    usciA1UartTxString(num);
+}
+
+/************************************************************************************
+* Function: cmdCaptureReplay
+* - runs the captured lines through parseCmd and executeCMD with every command flushed, as
+*   the benches do, then reports lines run, time and LCD bus bytes. capture is paused while
+*   it runs.
+*   timed replay starts each line at its recorded time since the first one, sleeping on the
+*   CCR1 alarm, so the CCR0 tick stays free for the replayed commands. a command that runs
+*   longer than the gap after it delays the next line, the ones after keep their times.
+* arguments:
+*   nok5110Cmds - command table
+*   timed - 0 back to back, 1 wait the recorded gaps in LPM0
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void cmdCaptureReplay(CMD* nok5110Cmds, unsigned char timed){
+    char line[BUFF_SZ];
+    unsigned int i = capTail;
+    unsigned int dt, n = 0, bad = 0;
+    unsigned long gaps = 0, work = 0, t0, tCmd, bytes;
+    unsigned char on = capOn;
+    unsigned char defer;
+    int cmdIndex;
+
+    capOn = 0;                                  // replayed lines are not captured again
+    defer = nokLcdDeferFlush(0);
+    bytes = nokLcdBusBytes();
+    t0 = timerB0Now();
+
+    while (i != capHead){
+        i = cmdCaptureRead(i, &dt, line);
+        if (timed){
+            gaps += dt;
+            cmdCaptureSleepUntil(t0 + (unsigned long)((unsigned long long)gaps * TIMERB0_CLK_HZ / 1000));
+        }
+        tCmd = timerB0Now();
+        cmdIndex = parseCmd(nok5110Cmds, line);
+        if (cmdIndex == -1 || cmdIndex == CAPTURE_IDX || cmdIndex == REPLAY_IDX)
+            bad++;
+        else
+            executeCMD(nok5110Cmds, cmdIndex);
+        if (cmdIndex != -1)
+            nok5110Cmds[cmdIndex].text = 0;
+        work += timerB0Now() - tCmd;
+        n++;
+    }
+
+    t0 = timerB0TicksToUs(timerB0Now() - t0);
+    timerB0AlarmStop();
+    bytes = nokLcdBusBytes() - bytes;
+    nokLcdDeferFlush(defer);
+    capOn = on;
+
+    sprintf(line, "replay %u lines (%u rejected) %lu us, %lu us in commands\r\n", n, bad, t0,
+            timerB0TicksToUs(work));
+    usciA1UartTxString(line);
+    if (timed){
+        sprintf(line, "recorded gaps %lu ms\r\n", gaps);
+        usciA1UartTxString(line);
+    }
+    sprintf(line, "bus bytes %lu, %lu per line\r\n", bytes, n ? bytes / n : 0);
+    usciA1UartTxString(line);
+}
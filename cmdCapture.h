@@ -0,0 +1,132 @@
+/*************************************************************************************************
+ * cmdCapture.h
+ * - C interface file for recording command sessions and replaying them.
+ *   While capture is on, the parse stage stores every accepted command line in a RAM ring
+ *   together with the time since the previous one. When the ring is full the oldest lines
+ *   are dropped. capture and replay themselves are never recorded.
+ *   Replay feeds the recorded lines back through parseCmd and executeCMD, either back to back
+ *   or keeping the recorded gaps on a Timer_B0 CCR1 alarm, then reports time and LCD bus
+ *   bytes.
+ *
+ *   Ring record: dt low, dt high, length, then length chars (no terminator).
+ *   dt is in ms since the previous record, 0 for the first one, saturated at 65535.
+ *
+ *   Dump:
+ *     @CAP <lines>\r\n
+ *     <dt> <command line>\r\n     one per record, oldest first
+ *     @END <dropped>\r\n
+ *   A host can store the dump as a session file and send the command lines back with the
+ *   same gaps to drive another board the same way.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#ifndef CMDCAPTURE_H_
+#define CMDCAPTURE_H_
+
+#include "cmdNok5110LCD.h"
+
+#define CAPTURE_BUF_SZ      1024    // ring bytes. must be a power of 2
+#define CAPTURE_BUF_MASK    (CAPTURE_BUF_SZ - 1)
+#define CAPTURE_HDR         3       // dt (2 bytes) + length
+
+/************************************************************************************
+* Function: cmdCaptureStart
+* - starts recording accepted command lines. the first one gets dt 0
+* argument: none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void cmdCaptureStart(void);
+
+/************************************************************************************
+* Function: cmdCaptureStop
+* - stops recording. the ring keeps what was captured
+* argument: none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void cmdCaptureStop(void);
+
+/************************************************************************************
+* Function: cmdCaptureClear
+* - empties the ring and clears the dropped count
+* argument: none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void cmdCaptureClear(void);
+
+/************************************************************************************
+* Function: cmdCaptureActive
+* - tells the parse stage whether to keep a copy of the raw line
+* argument: none
+* return: 1 while recording, else 0
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned char cmdCaptureActive(void);
+
+/************************************************************************************
+* Function: cmdCaptureLine
+* - records one accepted command line with the ms since the previous one. does nothing
+*   when capture is off, or for the capture and replay commands
+* arguments:
+*   cmdIndex - index parseCmd returned for the line
+*   line - the line as received, before parseCmd split it
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void cmdCaptureLine(int cmdIndex, const char* line);
+
+/************************************************************************************
+* Function: cmdCaptureReport
+* - prints whether capture is on, lines and bytes held, and lines dropped over UART A1
+* argument: none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void cmdCaptureReport(void);
+
+/************************************************************************************
+* Function: cmdCaptureDump
+* - sends the ring oldest first in the dump format (see cmdCapture.h) over UART A1
+* argument: none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void cmdCaptureDump(void);
+
+/************************************************************************************
+* Function: cmdCaptureReplay
+* - runs the captured lines through parseCmd and executeCMD with every command flushed, as
+*   the benches do, then reports lines run, time and LCD bus bytes. capture is paused while
+*   it runs.
+*   timed replay starts each line at its recorded time since the first one, sleeping on the
+*   CCR1 alarm, so the CCR0 tick stays free for the replayed commands. a command that runs
+*   longer than the gap after it delays the next line, the ones after keep their times.
+* arguments:
+*   nok5110Cmds - command table
+*   timed - 0 back to back, 1 wait the recorded gaps in LPM0
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void cmdCaptureReplay(CMD* nok5110Cmds, unsigned char timed);
+
+#endif /* CMDCAPTURE_H_ */
@@ -1,137 +1,347 @@
-#include <cmdNok5110LCD.h>
-#include <msp430.h>
-#include <string.h>
-#include <stdio.h>
-#include <stdlib.h>
-#include <nok5110LCD.h>
-#include <ctype.h>
-
-/************************************************************************************
-* Function: initNok5110Cmds
-* Purpose: initialize each index of the array with its correspondent string and nArgs
-* arguments:
-*   nok5110Cmds   -   CMD
-* return:  none
-* Author: Marcus Kuhn
-* Date: 22/04/2020
-* Modified: 22/04/2020
-*************************************************************************************/
-void initNok5110Cmds(CMD* nok5110Cmds){
-    nok5110Cmds[0].name = CMD0;        // initialize the first command name
-    nok5110Cmds[0].nArgs = CMD0_NARGS; // initialize num of arguments in first command
-    nok5110Cmds[1].name = CMD1;
-    nok5110Cmds[1].nArgs = CMD1_NARGS;
-    nok5110Cmds[2].name = CMD2;
-    nok5110Cmds[2].nArgs = CMD2_NARGS;
-}
-
-/************************************************************************************
-* Function: parseCmd
-* Purpose: splits strings into separate tokens for specific purposes
-* arguments:
-*   nok5110Cmds   -   CMD
-*   cmdLine   -   char*
-* return:  if command was valid
-* Author: Marcus Kuhn
-* Date: 22/04/2020
-* Modified: 22/04/2020
-*************************************************************************************/
-int parseCmd(CMD* nok5110Cmds, char* cmdLine){
-    char* token;  // a pointer variable to a string.
-    //char* con;
-    int i = 0;
-
-    // token is assigned the pointer to the token returned by strtok_s
-    token = strtok(cmdLine, DELIM);
-
-    int cmdIndex = validateCmd(nok5110Cmds, token);     // finds which index to use for subsequent parsing
-
-    if (cmdIndex != -1 && nok5110Cmds[cmdIndex].nArgs == 0){
-        token = strtok(NULL, DELIM);
-        if (token)     // if there is any arguments, function will return -1
-            cmdIndex = -1;
-    }
-    if (cmdIndex != -1 && nok5110Cmds[cmdIndex].nArgs != 0){
-//        if (cmdIndex == _IDX){      // for scaraMotorSpeed, nArgs = 1
-//                token = strtok(NULL, DELIM);
-//                // checks if token exists, is of length 1 and is alphabetic
-//                if (token && isdigit((int)*token))
-//                    ARGS[0] = atoi(token);            // casts as integer the value (of a char) token is pointing to
-//                else
-//                    cmdIndex = -1;      //
-//                //if(!token)                 // if token is NULL, command is invalid, function will return -1
-//                //    cmdIndex = -1;
-//                token = strtok(NULL, DELIM);
-//                if (token)     // if there is more than one argument, function will also return -1
-//                    cmdIndex = -1;
-//        }
-        if (cmdIndex == SCRNLINE_IDX || cmdIndex == DRAWLINE_IDX){      // for nokLcdDrawScrnLine, nArgs = 2, for nokLcdDrawLine, nArgs = 4
-            for (i = 0; token && i < nok5110Cmds[cmdIndex].nArgs; ++i){      // loops while token is valid and i is less than the nArgs for the command, same for every following for-loop
-                token = strtok(NULL, DELIM);
-                if (token)                                              // every following token here will be a double
-                    NOK_ARG[i] = atoi(token);            // converts to int, then stores into the array
-                else if (!token)                // token invalid in the range of nArgs
-                    cmdIndex = -1;
-            }
-            if (token = strtok(NULL, DELIM))     // looks for more than nArgs arguments, which will also make the function return -1
-                cmdIndex = -1;
-        }
-    }
-    return cmdIndex;
-}
-
-/************************************************************************************
-* Function: validadeCmd
-* Purpose: uses cmdIndex to execute a scaraCmds[cmdIndex] Scara command.
-* It will perform data type casting (double -> int or char) when necessary.
-* arguments:
-*   scaraCmds   -   CMD*
-*   cmdName     -   char*
-* return:  if command was valid
-* Author: Marcus Kuhn
-* Date: 22/04/2020
-* Modified: 22/04/2020
-*************************************************************************************/
-int validateCmd(CMD* nok5110Cmds, char* cmdName){
-    unsigned int i = 0;
-    int idx = -1;
-    int invalidCmd = 1;
-    while (invalidCmd && i < MAX_CMDS)
-        invalidCmd = strcmp(cmdName, nok5110Cmds[i++].name);
-    if (!invalidCmd)
-        idx = i - 1;
-    return idx;
-}
-
-/************************************************************************************
-* Function: executeCMD
-* Purpose: uses cmdIndex to execute a scaraCmds[cmdIndex] Scara command.
-* It will perform data type casting (double -> int or char) when necessary.
-* arguments:
-*   scaraCmds   -   CMD*
-*   cmdIndex   -   int
-*   scaraState   -   SCARA_ROBOT*
-* return:  if command was valid
-* Author: Marcus Kuhn
-* Date: 22/04/2020
-* Modified: 22/04/2020
-*************************************************************************************/
-int executeCMD(CMD* nok5110Cmds, int cmdIndex){
-    switch (cmdIndex) {
-    case SCRNLINE_IDX:
-        if(NOK_ARG[2] == 0)
-            nokLcdDrawScrnLine(NOK_ARG[0],NOK_ARG[1], 'H');
-        else if(NOK_ARG[2] == 1)
-            nokLcdDrawScrnLine(NOK_ARG[0],NOK_ARG[1], 'V');
-        break;
-    case DRAWLINE_IDX:
-        nokLcdDrawLine(NOK_ARG[0], NOK_ARG[1], NOK_ARG[2], NOK_ARG[3]);
-        break;
-    case CLEAR_IDX:
-        nokLcdClear();
-        break;
-    default:
-        break;
-    }
-    return cmdIndex;
-}
+#include <cmdNok5110LCD.h>
+#include <msp430.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <nok5110LCD.h>
+#include <ctype.h>
+#include "profStats.h"
+#include "usciSpi.h"
+#include "ucsClock.h"
+#include "events.h"
+#include "nokConsole.h"
+#include "nokStripChart.h"
+#include "nokFill.h"
+#include "usciUart.h"
+#include "sched.h"
+#include "nokSprite.h"
+#include "nokSnapshot.h"
+#include "cmdCapture.h"
+#include "nokWidget.h"
+
+/************************************************************************************
+* Function: initNok5110Cmds
+* Purpose: initialize each index of the array with its correspondent string and nArgs
+* arguments:
+*   nok5110Cmds   -   CMD
+* return:  none
+* Author: Marcus Kuhn
+* Date: 22/04/2020
+* Modified: 22/04/2020
+*************************************************************************************/
+void initNok5110Cmds(CMD* nok5110Cmds){
+    int i;
+    for (i = 0; i < MAX_CMDS; i++)
+        nok5110Cmds[i].text = 0;            // only commands that take text set it
+
+    nok5110Cmds[0].name = CMD0;        // initialize the first command name
+    nok5110Cmds[0].nArgs = CMD0_NARGS; // initialize num of arguments in first command
+    nok5110Cmds[1].name = CMD1;
+    nok5110Cmds[1].nArgs = CMD1_NARGS;
+    nok5110Cmds[2].name = CMD2;
+    nok5110Cmds[2].nArgs = CMD2_NARGS;
+    nok5110Cmds[3].name = CMD3;
+    nok5110Cmds[3].nArgs = CMD3_NARGS;
+    nok5110Cmds[4].name = CMD4;
+    nok5110Cmds[4].nArgs = CMD4_NARGS;
+    nok5110Cmds[5].name = CMD5;
+    nok5110Cmds[5].nArgs = CMD5_NARGS;
+    nok5110Cmds[6].name = CMD6;
+    nok5110Cmds[6].nArgs = CMD6_NARGS;
+    nok5110Cmds[7].name = CMD7;
+    nok5110Cmds[7].nArgs = CMD7_NARGS;
+    nok5110Cmds[8].name = CMD8;
+    nok5110Cmds[8].nArgs = CMD8_NARGS;
+    nok5110Cmds[9].name = CMD9;
+    nok5110Cmds[9].nArgs = CMD9_NARGS;
+    nok5110Cmds[10].name = CMD10;
+    nok5110Cmds[10].nArgs = CMD10_NARGS;
+    nok5110Cmds[11].name = CMD11;
+    nok5110Cmds[11].nArgs = CMD11_NARGS;
+    nok5110Cmds[12].name = CMD12;
+    nok5110Cmds[12].nArgs = CMD12_NARGS;
+    nok5110Cmds[13].name = CMD13;
+    nok5110Cmds[13].nArgs = CMD13_NARGS;
+    nok5110Cmds[14].name = CMD14;
+    nok5110Cmds[14].nArgs = CMD14_NARGS;
+    nok5110Cmds[15].name = CMD15;
+    nok5110Cmds[15].nArgs = CMD15_NARGS;
+    nok5110Cmds[16].name = CMD16;
+    nok5110Cmds[16].nArgs = CMD16_NARGS;
+    nok5110Cmds[17].name = CMD17;
+    nok5110Cmds[17].nArgs = CMD17_NARGS;
+    nok5110Cmds[18].name = CMD18;
+    nok5110Cmds[18].nArgs = CMD18_NARGS;
+    nok5110Cmds[19].name = CMD19;
+    nok5110Cmds[19].nArgs = CMD19_NARGS;
+    nok5110Cmds[20].name = CMD20;
+    nok5110Cmds[20].nArgs = CMD20_NARGS;
+    nok5110Cmds[21].name = CMD21;
+    nok5110Cmds[21].nArgs = CMD21_NARGS;
+    nok5110Cmds[22].name = CMD22;
+    nok5110Cmds[22].nArgs = CMD22_NARGS;
+    nok5110Cmds[23].name = CMD23;
+    nok5110Cmds[23].nArgs = CMD23_NARGS;
+    nok5110Cmds[24].name = CMD24;
+    nok5110Cmds[24].nArgs = CMD24_NARGS;
+    nok5110Cmds[25].name = CMD25;
+    nok5110Cmds[25].nArgs = CMD25_NARGS;
+}
+
+/************************************************************************************
+* Function: parseCmd
+* Purpose: splits strings into separate tokens for specific purposes
+* arguments:
+*   nok5110Cmds   -   CMD
+*   cmdLine   -   char*
+* return:  if command was valid
+* Author: Marcus Kuhn
+* Date: 22/04/2020
+* Modified: 22/04/2020
+*************************************************************************************/
+int parseCmd(CMD* nok5110Cmds, char* cmdLine){
+    char* token;  // a pointer variable to a string.
+    //char* con;
+    int i = 0;
+
+    // token is assigned the pointer to the token returned by strtok_s
+    token = strtok(cmdLine, DELIM);
+
+    int cmdIndex = validateCmd(nok5110Cmds, token);     // finds which index to use for subsequent parsing
+
+    if (cmdIndex != -1 && nok5110Cmds[cmdIndex].nArgs == 0){
+        token = strtok(NULL, DELIM);
+        if (token)     // if there is any arguments, function will return -1
+            cmdIndex = -1;
+    }
+    if (cmdIndex != -1 && nok5110Cmds[cmdIndex].nArgs != 0){
+//        if (cmdIndex == _IDX){      // for scaraMotorSpeed, nArgs = 1
+//                token = strtok(NULL, DELIM);
+//                // checks if token exists, is of length 1 and is alphabetic
+//                if (token && isdigit((int)*token))
+//                    ARGS[0] = atoi(token);            // casts as integer the value (of a char) token is pointing to
+//                else
+//                    cmdIndex = -1;      //
+//                //if(!token)                 // if token is NULL, command is invalid, function will return -1
+//                //    cmdIndex = -1;
+//                token = strtok(NULL, DELIM);
+//                if (token)     // if there is more than one argument, function will also return -1
+//                    cmdIndex = -1;
+//        }
+        if (cmdIndex == STATS_IDX){       // stats [reset]. the argument is optional
+            token = strtok(NULL, DELIM);
+            NOK_ARG[0] = 0;
+            if (token && !strcmp(token, STATS_RESET))
+                NOK_ARG[0] = 1;
+            else if (token)
+                cmdIndex = -1;
+            if (token && strtok(NULL, DELIM))
+                cmdIndex = -1;
+        }
+        else if (cmdIndex == SPITRACE_IDX){    // spiTrace [dump | reset]. no argument prints the analysis
+            token = strtok(NULL, DELIM);
+            NOK_ARG[0] = 0;
+            if (token && !strcmp(token, SPITRACE_DUMP))
+                NOK_ARG[0] = 1;
+            else if (token && !strcmp(token, SPITRACE_RESET))
+                NOK_ARG[0] = 2;
+            else if (token)
+                cmdIndex = -1;
+            if (token && strtok(NULL, DELIM))
+                cmdIndex = -1;
+        }
+        else if (cmdIndex == CAPTURE_IDX){     // capture [start | stop | dump | clear]. no argument prints the status
+            token = strtok(NULL, DELIM);
+            NOK_ARG[0] = 0;
+            if (token && !strcmp(token, CAPTURE_START))
+                NOK_ARG[0] = 1;
+            else if (token && !strcmp(token, CAPTURE_STOP))
+                NOK_ARG[0] = 2;
+            else if (token && !strcmp(token, CAPTURE_DUMP))
+                NOK_ARG[0] = 3;
+            else if (token && !strcmp(token, CAPTURE_CLEAR))
+                NOK_ARG[0] = 4;
+            else if (token)
+                cmdIndex = -1;
+            if (token && strtok(NULL, DELIM))
+                cmdIndex = -1;
+        }
+        else if (cmdIndex == REPLAY_IDX){      // replay [timed]. back to back without the argument
+            token = strtok(NULL, DELIM);
+            NOK_ARG[0] = 0;
+            if (token && !strcmp(token, REPLAY_TIMED))
+                NOK_ARG[0] = 1;
+            else if (token)
+                cmdIndex = -1;
+            if (token && strtok(NULL, DELIM))
+                cmdIndex = -1;
+        }
+        else if (cmdIndex == PRINT_IDX){       // print <text>. the rest of the line, delimiters included
+            NOK_TEXT = strtok(NULL, "");
+            if (!NOK_TEXT)
+                NOK_TEXT = "";
+        }
+        else {      // every other command takes nArgs integer arguments. ex: nokLcdDrawLine, nArgs = 4
+            for (i = 0; token && i < nok5110Cmds[cmdIndex].nArgs; ++i){      // loops while token is valid and i is less than the nArgs for the command, same for every following for-loop
+                token = strtok(NULL, DELIM);
+                if (token)                                              // every following token here will be a double
+                    NOK_ARG[i] = atoi(token);            // converts to int, then stores into the array
+                else if (!token)                // token invalid in the range of nArgs
+                    cmdIndex = -1;
+            }
+            if ((token = strtok(NULL, DELIM)))   // looks for more than nArgs arguments, which will also make the function return -1
+                cmdIndex = -1;
+        }
+    }
+    return cmdIndex;
+}
+
+/************************************************************************************
+* Function: validadeCmd
+* Purpose: uses cmdIndex to execute a scaraCmds[cmdIndex] Scara command.
+* It will perform data type casting (double -> int or char) when necessary.
+* arguments:
+*   scaraCmds   -   CMD*
+*   cmdName     -   char*
+* return:  if command was valid
+* Author: Marcus Kuhn
+* Date: 22/04/2020
+* Modified: 22/04/2020
+*************************************************************************************/
+int validateCmd(CMD* nok5110Cmds, char* cmdName){
+    unsigned int i = 0;
+    int idx = -1;
+    int invalidCmd = 1;
+    if (!cmdName)                   // empty line
+        return idx;
+    while (invalidCmd && i < MAX_CMDS)
+        invalidCmd = strcmp(cmdName, nok5110Cmds[i++].name);
+    if (!invalidCmd)
+        idx = i - 1;
+    return idx;
+}
+
+/************************************************************************************
+* Function: executeCMD
+* Purpose: uses cmdIndex to execute a scaraCmds[cmdIndex] Scara command.
+* It will perform data type casting (double -> int or char) when necessary.
+* arguments:
+*   scaraCmds   -   CMD*
+*   cmdIndex   -   int
+*   scaraState   -   SCARA_ROBOT*
+* return:  if command was valid
+* Author: Marcus Kuhn
+* Date: 22/04/2020
+* Modified: 22/04/2020
+*************************************************************************************/
+int executeCMD(CMD* nok5110Cmds, int cmdIndex){
+    switch (cmdIndex) {
+    case SCRNLINE_IDX:
+        if(NOK_ARG[2] == 0)
+            nokLcdDrawScrnLine(NOK_ARG[0],NOK_ARG[1], 'H');
+        else if(NOK_ARG[2] == 1)
+            nokLcdDrawScrnLine(NOK_ARG[0],NOK_ARG[1], 'V');
+        break;
+    case DRAWLINE_IDX:
+        nokLcdDrawLine(NOK_ARG[0], NOK_ARG[1], NOK_ARG[2], NOK_ARG[3]);
+        break;
+    case CLEAR_IDX:
+        nokLcdClear();
+        break;
+    case STATS_IDX:
+        if (NOK_ARG[0])
+            profStatsReset();
+        else
+            profStatsPrint(nok5110Cmds);
+        break;
+    case SPITRACE_IDX:
+        if (NOK_ARG[0] == 1)
+            usciB1SpiTraceDump();
+        else if (NOK_ARG[0] == 2)
+            usciB1SpiTraceReset();
+        else
+            usciB1SpiTraceReport();
+        break;
+    case CLOCKINFO_IDX:
+        ucsClockReport();
+        break;
+    case POWER_IDX:
+        eventReport(nok5110Cmds);
+        break;
+    case PRINT_IDX:
+        nokConsolePuts(NOK_TEXT);
+        nokConsolePuts("\n");
+        break;
+    case CONBENCH_IDX:
+        nokConsoleBench(NOK_ARG[0]);
+        break;
+    case STRIP_IDX:
+        nokStripPlot(NOK_ARG[0]);
+        break;
+    case STRIPINIT_IDX:
+        if (nokStripInit(NOK_ARG[0], NOK_ARG[1], NOK_ARG[2]) == -1)
+            usciA1UartTxString("stripInit needs vMin < vMax and mode 0 or 1\r\n");
+        break;
+    case STRIPBENCH_IDX:
+        nokStripBench(NOK_ARG[0]);
+        break;
+    case ROTATE_IDX:
+        if (nokLcdSetRotation(NOK_ARG[0], NOK_ARG[1]) == 0)
+            nokConsoleClear();                  // home the cursor on the new grid
+        break;
+    case FILL_IDX:
+        nokLcdFill(NOK_ARG[0], NOK_ARG[1], NOK_ARG[2], NOK_ARG[3]);
+        break;
+    case FILLRECT_IDX:
+        nokLcdFillRect(NOK_ARG[0], NOK_ARG[1], NOK_ARG[2], NOK_ARG[3], 1);
+        break;
+    case SCHED_IDX:
+        schedReport();
+        break;
+    case SPRITEDEMO_IDX:
+        if (nokSpriteDemo(NOK_ARG[0], NOK_ARG[1]) == -1)
+            usciA1UartTxString("spriteDemo needs frames and tickHz above 0\r\n");
+        break;
+    case SLEEP_IDX:
+        nokLcdSleep(NOK_ARG[0]);
+        break;
+    case WAKE_IDX:
+        nokLcdResume(NOK_ARG[0]);
+        break;
+    case STARTBENCH_IDX:
+        nokLcdStartBench();
+        break;
+    case SNAPSHOT_IDX:
+        nokSnapshotSend();
+        break;
+    case CAPTURE_IDX:
+        if (NOK_ARG[0] == 1)
+            cmdCaptureStart();
+        else if (NOK_ARG[0] == 2)
+            cmdCaptureStop();
+        else if (NOK_ARG[0] == 3)
+            cmdCaptureDump();
+        else if (NOK_ARG[0] == 4)
+            cmdCaptureClear();
+        else
+            cmdCaptureReport();
+        break;
+    case REPLAY_IDX:
+        cmdCaptureReplay(nok5110Cmds, NOK_ARG[0]);
+        break;
+    case WIDGETINIT_IDX:
+        if (nokWidgetDashboard() != 0)
+            usciA1UartTxString("dashboard does not fit\r\n");
+        break;
+    case WIDGETSET_IDX:
+        if (nokWidgetSet(NOK_ARG[0], NOK_ARG[1]) == 0)
+            nokLcdFlush();
+        break;
+    case WIDGETBENCH_IDX:
+        nokWidgetBench(NOK_ARG[0]);
+        break;
+    default:
+        break;
+    }
+    return cmdIndex;
+}
@@ -1,45 +1,149 @@
-/*
- * cmdVNH7070.h
- *
- *  Created on: Feb 23, 2021
- *      Author: Raymond
- */
-
-#ifndef CMDNOK5110LCD_H_
-#define CMDNOK5110LCD_H_
-
-#define     MAX_CMDS             3
-
-#define     CMD0                 "nokLcdDrawScrnLine"
-#define     CMD0_NARGS           3
-#define     SCRNLINE_IDX         0
-
-#define     CMD1                 "nokLcdDrawLine"
-#define     CMD1_NARGS           4
-#define     DRAWLINE_IDX         1
-
-#define     CMD2                 "nokLcdClear"
-#define     CMD2_NARGS           0
-#define     CLEAR_IDX            2
-
-#define     DELIM                " ,\t"
-#define     NULL                 '\0'          // null char
-#define     NOK_ARG              nok5110Cmds[cmdIndex].args
-#define     MAX_ARGS             4
-
-#define     QUIT_IDX             6
-
-typedef struct CMD {
-    const char *name; // command name
-    int nArgs; // number of input arguments for a command
-    int args[MAX_ARGS]; // arguments
-}CMD;
-
-//-------------- func prototypes-------------
-
-void initNok5110Cmds(CMD* vnh7070Cmds);
-int parseCmd(CMD* vnh7070Cmds, char* cmdLine);
-int validateCmd(CMD* scaraCmds, char* cmdName);
-int executeCMD(CMD* vnh7070Cmds, int cmdIndex);
-
-#endif /* CMDNOK5110LCD_H_ */
+/*
+ * cmdVNH7070.h
+ *
+ *  Created on: Feb 23, 2021
+ *      Author: Raymond
+ */
+
+#ifndef CMDNOK5110LCD_H_
+#define CMDNOK5110LCD_H_
+
+#define     MAX_CMDS             26
+
+#define     CMD0                 "nokLcdDrawScrnLine"
+#define     CMD0_NARGS           3
+#define     SCRNLINE_IDX         0
+
+#define     CMD1                 "nokLcdDrawLine"
+#define     CMD1_NARGS           4
+#define     DRAWLINE_IDX         1
+
+#define     CMD2                 "nokLcdClear"
+#define     CMD2_NARGS           0
+#define     CLEAR_IDX            2
+
+#define     CMD3                 "stats"
+#define     CMD3_NARGS           1              // optional "reset"
+#define     STATS_IDX            3
+#define     STATS_RESET          "reset"
+
+#define     CMD4                 "spiTrace"
+#define     CMD4_NARGS           1              // optional "dump" or "reset"
+#define     SPITRACE_IDX         4
+#define     SPITRACE_DUMP        "dump"
+#define     SPITRACE_RESET       "reset"
+
+#define     CMD5                 "clockInfo"
+#define     CMD5_NARGS           0
+#define     CLOCKINFO_IDX        5
+
+#define     CMD6                 "power"
+#define     CMD6_NARGS           0
+#define     POWER_IDX            6
+
+#define     CMD7                 "print"
+#define     CMD7_NARGS           1              // rest of the line as text
+#define     PRINT_IDX            7
+
+#define     CMD8                 "consoleBench"
+#define     CMD8_NARGS           1
+#define     CONBENCH_IDX         8
+
+#define     CMD9                 "s"            // short on purpose: one strip chart sample per line
+#define     CMD9_NARGS           1
+#define     STRIP_IDX            9
+
+#define     CMD10                "stripInit"
+#define     CMD10_NARGS          3              // min max mode (0 scroll, 1 sweep)
+#define     STRIPINIT_IDX        10
+
+#define     CMD11                "stripBench"
+#define     CMD11_NARGS          1
+#define     STRIPBENCH_IDX       11
+
+#define     CMD12                "nokLcdRotate"
+#define     CMD12_NARGS          2              // degrees (0 90 180 270) mirror (0 1)
+#define     ROTATE_IDX           12
+
+#define     CMD13                "nokLcdFill"
+#define     CMD13_NARGS          4              // x y conn (4 or 8) colour (0 or 1)
+#define     FILL_IDX             13
+
+#define     CMD14                "nokLcdFillRect"
+#define     CMD14_NARGS          4              // x0 y0 x1 y1
+#define     FILLRECT_IDX         14
+
+#define     CMD15                "sched"
+#define     CMD15_NARGS          0
+#define     SCHED_IDX            15
+
+#define     CMD16                "spriteDemo"
+#define     CMD16_NARGS          2              // frames tickHz
+#define     SPRITEDEMO_IDX       16
+
+#define     CMD17                "nokLcdSleep"
+#define     CMD17_NARGS          1              // keepRam (1 keep panel RAM, 0 zero it)
+#define     SLEEP_IDX            17
+
+#define     CMD18                "nokLcdWake"
+#define     CMD18_NARGS          1              // retained (1 panel RAM kept, 0 restore all of it)
+#define     WAKE_IDX             18
+
+#define     CMD19                "lcdStartBench"
+#define     CMD19_NARGS          0
+#define     STARTBENCH_IDX       19
+
+#define     CMD20                "snapshot"
+#define     CMD20_NARGS          0
+#define     SNAPSHOT_IDX         20
+
+#define     CMD21                "capture"
+#define     CMD21_NARGS          1              // start | stop | dump | clear. no argument prints the status
+#define     CAPTURE_IDX          21
+#define     CAPTURE_START        "start"
+#define     CAPTURE_STOP         "stop"
+#define     CAPTURE_DUMP         "dump"
+#define     CAPTURE_CLEAR        "clear"
+
+#define     CMD22                "replay"
+#define     CMD22_NARGS          1              // optional "timed" to keep the recorded gaps
+#define     REPLAY_IDX           22
+#define     REPLAY_TIMED         "timed"
+
+#define     CMD23                "widgetInit"
+#define     CMD23_NARGS          0              // sample dashboard, widgets 0 to 3
+#define     WIDGETINIT_IDX       23
+
+#define     CMD24                "widgetSet"
+#define     CMD24_NARGS          2              // id value
+#define     WIDGETSET_IDX        24
+
+#define     CMD25                "widgetBench"
+#define     CMD25_NARGS          1              // updates per widget
+#define     WIDGETBENCH_IDX      25
+
+#define     DELIM                " ,\t"
+#ifndef NULL                                        // <stdlib.h> may have it already
+#define     NULL                 '\0'          // null char
+#endif
+#define     NOK_ARG              nok5110Cmds[cmdIndex].args
+#define     NOK_TEXT             nok5110Cmds[cmdIndex].text
+#define     MAX_ARGS             4
+
+#define     QUIT_IDX             MAX_CMDS       // no quit command. parseCmd never returns this index
+
+typedef struct CMD {
+    const char *name; // command name
+    int nArgs; // number of input arguments for a command
+    int args[MAX_ARGS]; // arguments
+    char *text; // rest of the command line, for commands that take free text
+}CMD;
+
+//-------------- func prototypes-------------
+
+void initNok5110Cmds(CMD* vnh7070Cmds);
+int parseCmd(CMD* vnh7070Cmds, char* cmdLine);
+int validateCmd(CMD* scaraCmds, char* cmdName);
+int executeCMD(CMD* vnh7070Cmds, int cmdIndex);
+
+#endif /* CMDNOK5110LCD_H_ */
@@ -0,0 +1,123 @@
+/*************************************************************************************************
+ * events.c
+ * - C implementation or source file for the event flags that wake the main loop from LPM0.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+#include <stdio.h>
+
+#include "events.h"
+#include "timerB0.h"
+#include "ucsClock.h"
+#include "usciUart.h"
+
+#define EVT_LINE_SZ     (40 + 4 * 3 * sizeof(unsigned long))    // the summary line with four longs at full width
+
+volatile unsigned int eventFlags = 0;           // pending EVT_xxx. set by ISRs, cleared by eventWait
+
+static unsigned long evtSleepTicks = 0;         // total time in LPM0
+static unsigned long evtSleepSinceCmd = 0;      // time in LPM0 since the last accounted command
+static unsigned long evtStart = 0;              // timestamp of the first eventWait
+
+// per command accounting. sleep is charged to the command that ended the wait
+static unsigned int evtCmdCount[MAX_CMDS];
+static unsigned long evtCmdActive[MAX_CMDS];
+static unsigned long evtCmdSleep[MAX_CMDS];
+
+/************************************************************************************
+* Function: eventWait
+* - sleeps in LPM0 until any event in evtMask is pending, then clears and returns those
+*   events. Entering LPM0 and setting GIE happen in one instruction so an event posted
+*   right before going to sleep cannot be missed.
+* arguments:
+*   evtMask - EVT_xxx events to wait for
+* return: the events that were pending (subset of evtMask)
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+*************************************************************************************/
+unsigned int eventWait(unsigned int evtMask){
+    unsigned long t0;
+    unsigned int evt;
+
+    if (evtStart == 0)
+        evtStart = timerB0Now();
+
+    __disable_interrupt();
+    while (!(eventFlags & evtMask)){
+        t0 = timerB0Now();
+        __bis_SR_register(LPM0_bits + GIE);     // sleep. the ISR that posts an event clears LPM0 on exit
+        __disable_interrupt();
+        t0 = timerB0Now() - t0;
+        evtSleepTicks += t0;
+        evtSleepSinceCmd += t0;
+    }
+    evt = eventFlags & evtMask;
+    eventFlags &= ~evt;
+    __enable_interrupt();
+
+    return evt;
+}
+
+/************************************************************************************
+* Function: eventAccountCmd
+* - charges the time a command was awake for, and the sleep that preceded it, to the command
+* arguments:
+*   cmdIndex    - index of the command that ran
+*   activeTicks - TB0 ticks from wake up to the end of the command
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+*************************************************************************************/
+void eventAccountCmd(int cmdIndex, unsigned long activeTicks){
+    if (cmdIndex < 0 || cmdIndex >= MAX_CMDS)
+        return;
+    evtCmdCount[cmdIndex]++;
+    evtCmdActive[cmdIndex] += activeTicks;
+    evtCmdSleep[cmdIndex] += evtSleepSinceCmd;
+    evtSleepSinceCmd = 0;
+}
+
+/************************************************************************************
+* Function: eventReport
+* - prints active vs sleep time since the first eventWait, the estimated charge drawn by
+*   the CPU, and per command count, mean active time and sleep charged to it
+* arguments:
+*   nok5110Cmds - command table, used for the command names
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+*************************************************************************************/
+void eventReport(CMD* nok5110Cmds){
+    char line[EVT_LINE_SZ];
+    unsigned long totalUs = timerB0TicksToUs(timerB0Now() - evtStart);
+    unsigned long sleepUs = timerB0TicksToUs(evtSleepTicks);
+    unsigned long activeUs = (totalUs > sleepUs) ? totalUs - sleepUs : 0;
+    unsigned long mhz = ucsClockSmclkHz() / 1000000UL;
+    unsigned long long chargeNc;        // nC = us x uA / 1000
+    unsigned int i;
+
+    chargeNc = ((unsigned long long)activeUs * EVT_AM_UA_PER_MHZ * mhz
+              + (unsigned long long)sleepUs * EVT_LPM0_UA) / 1000;
+
+    sprintf(line, "active %lu ms sleep %lu ms (%lu%% awake) ~%lu uC\r\n",
+            activeUs / 1000, sleepUs / 1000,
+            totalUs ? (unsigned long)((unsigned long long)activeUs * 100 / totalUs) : 0,
+            (unsigned long)(chargeNc / 1000));
+    usciA1UartTxString(line);
+
+    usciA1UartTxString("cmd n activeMean(us) sleep(ms)\r\n");
+    for (i = 0; i < MAX_CMDS; i++){
+        if (evtCmdCount[i] == 0)
+            continue;
+        sprintf(line, "%s %u %lu %lu\r\n", nok5110Cmds[i].name, evtCmdCount[i],
+                timerB0TicksToUs(evtCmdActive[i] / evtCmdCount[i]),
+                timerB0TicksToUs(evtCmdSleep[i]) / 1000);
+        usciA1UartTxString(line);
+    }
+}
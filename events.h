@@ -0,0 +1,36 @@
+/*************************************************************************************************
+ * events.h
+ * - C interface file for the event flags that wake the main loop from LPM0.
+ *   ISRs post an event with EVENT_POST_FROM_ISR, the main loop sleeps in eventWait until one
+ *   of the events it cares about is pending. Time spent asleep vs awake is accumulated so the
+ *   power command can report it per command.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#ifndef EVENTS_H_
+#define EVENTS_H_
+
+#include "cmdNok5110LCD.h"
+
+#define EVT_UART_LINE       BIT0        // usciA1 RX ISR assembled a complete line
+#define EVT_TICK            BIT1        // timerB0 periodic tick
+#define EVT_ALARM           BIT2        // timerB0 one-shot alarm
+
+// typical supply currents from the F5529 datasheet (3 V, flash execution) for the charge estimate
+#define EVT_AM_UA_PER_MHZ   290UL       // active mode, per MHz of MCLK
+#define EVT_LPM0_UA         83UL        // LPM0 (MCLK off, SMCLK on)
+
+// set the event and leave LPM0 when the ISR returns. only usable inside an ISR
+#define EVENT_POST_FROM_ISR(evt)    do { eventFlags |= (evt); __bic_SR_register_on_exit(LPM0_bits); } while (0)
+
+extern volatile unsigned int eventFlags;
+
+//-------------- func prototypes-------------
+
+unsigned int eventWait(unsigned int evtMask);
+void eventAccountCmd(int cmdIndex, unsigned long activeTicks);
+void eventReport(CMD* nok5110Cmds);
+
+#endif /* EVENTS_H_ */
@@ -0,0 +1,914 @@
+/*************************************************************************************************
+ * hostHw.c
+ * - C implementation or source file for the host simulation of the MSP430F5529 peripherals the
+ *   firmware touches. Event driven: SPI and UART shift ends, Timer_B0 overflow and compare
+ *   matches and received characters are scheduled in SMCLK cycles, and the clock jumps from one
+ *   to the next whenever the firmware waits on a flag or sleeps in LPM0. Interrupts are taken at
+ *   register accesses, in the F5529 vector priority order, when GIE is set.
+ *   The PCD8544 model latches a byte on its last SCLK with the D/C' level at that moment and
+ *   drops it if SCE' was high, VCC was off or RST' was never strobed, so a driver that changes
+ *   D/C' or SCE' too early shows up as a wrong picture or lostBytes.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+
+#include "cmdNok5110LCD.h"
+#include "nok5110LCD.h"
+#include "usciSpi.h"
+#include "usciUart.h"
+#include "timerB0.h"
+#include "ucsClock.h"
+#include "sched.h"
+#include "hostHw.h"
+
+// after the firmware headers: cmdNok5110LCD.h defines its own NULL, stddef.h puts the real one back
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HOST_NEVER          (~0ULL)
+#define HOST_TXBUF_EMPTY    0xFFFF0000u     // no write pending. a char written to TXBUF never looks like this
+#define HOST_RX_QUEUE       65536           // characters queued towards the UART
+#define HOST_SPIN_MAX       100000          // status reads in a row with no event left to wait for
+
+// interrupt service routines in the firmware
+void timerB0TickIsr(void);
+void timerB0Isr(void);
+void USCI_A1_ISR(void);
+
+//-------------- plain registers
+
+volatile unsigned char P2DIR, P4DIR, P4OUT, P4SEL, P6DIR, P6OUT, P8DIR, P8OUT;
+volatile unsigned char UCB1CTL0, UCB1CTL1, UCB1BR0, UCB1BR1, UCB1IE;
+volatile unsigned char UCA1CTL0, UCA1CTL1, UCA1BR0, UCA1BR1, UCA1MCTL, UCA1RXBUF, UCA1IE;
+volatile unsigned short UCB1IV;
+volatile unsigned short WDTCTL, SFRIFG1;
+volatile unsigned short TB0CTL, TB0CCTL0, TB0CCR0, TB0CCTL1, TB0CCR1;
+volatile unsigned short UCSCTL0, UCSCTL1, UCSCTL2, UCSCTL3, UCSCTL4, UCSCTL5, UCSCTL6, UCSCTL7;
+volatile unsigned short PMMCTL0, SVSMHCTL, SVSMLCTL;
+
+//-------------- registers behind the access functions
+
+static volatile unsigned char p2Out;
+static volatile unsigned char ucb1Ifg = UCTXIFG;
+static volatile unsigned char ucb1Stat;
+static volatile unsigned char ucb1RxBuf;
+static volatile unsigned int ucb1TxBuf = HOST_TXBUF_EMPTY;
+static volatile unsigned char uca1Ifg = UCTXIFG;
+static volatile unsigned char uca1Stat;
+static volatile unsigned int uca1TxBuf = HOST_TXBUF_EMPTY;
+static volatile unsigned short uca1Iv;
+static volatile unsigned short tb0R;
+static volatile unsigned short tb0Iv;
+static volatile unsigned short pmmIfg;
+
+//-------------- simulator state
+
+HOST_LCD hostLcd;
+static CMD hostCmds[MAX_CMDS];              // command table used by hostBoot and hostCmd
+
+static unsigned long long cyc = 0;          // SMCLK cycles since power up
+static unsigned long long sleepCyc = 0;     // of which in LPM0
+static unsigned long wakeups = 0;
+static unsigned int sr = 0;                 // status register
+static unsigned int isrSr;                  // status register pushed by the running ISR
+static unsigned char inIsr = 0;
+static unsigned long changes = 0;           // flags, buffers and pins the peripherals changed so far
+static const volatile void* pollReg = 0;    // status register read last
+static unsigned long pollChanges;           // changes when pollReg was first read in this run
+static unsigned int pollRun = 0;            // reads of pollReg in a row with nothing changed
+static unsigned int failures = 0;
+
+static jmp_buf idleJmp;
+static unsigned char idleArmed = 0;
+
+// a shift register with a one byte transmit buffer in front of it (both USCIs)
+typedef struct HOST_SHIFTER {
+    unsigned char busy;                     // shift register active
+    unsigned char full;                     // TXBUF holds a byte
+    unsigned char shift;                    // byte being shifted
+    unsigned char buf;                      // byte in TXBUF
+    unsigned char sce;                      // SPI: SCE' when the shift started
+    unsigned long long end;                 // cycle the last bit is done
+    unsigned int frac;                      // UART: fractional cycles carried, in 1/16ths
+} HOST_SHIFTER;
+
+static HOST_SHIFTER spi;
+static HOST_SHIFTER utx;
+
+// Timer_B0
+static unsigned long long tbBase = 0;       // cycle the count was zero
+static unsigned long long tbSeen = 0;       // timer events are processed up to here
+
+// PCD8544 pins
+static unsigned char lcdRstLow = 0;
+static unsigned long lcdSeed = 12345;
+
+// terminal side of the UART
+typedef struct HOST_RX {
+    unsigned long long at;
+    unsigned char ch;
+} HOST_RX;
+
+static HOST_RX rxQ[HOST_RX_QUEUE];
+static unsigned long rxHead = 0;            // next free
+static unsigned long rxTail = 0;            // next to deliver
+static unsigned long long rxLast = 0;       // end of the last queued character
+static unsigned long rxBaud = UART_BAUD;
+static unsigned long rxOverruns = 0;
+
+static char* txLog = 0;
+static unsigned long txLen = 0;
+static unsigned long txCap = 0;
+static unsigned long txCount = 0;
+static FILE* txEcho = 0;
+
+static void hostAdvance(unsigned long long target);
+
+//-- stops the run. a test that hangs or deadlocks fails instead of spinning forever
+static void hostDie(const char* fmt, ...){
+    va_list ap;
+
+    va_start(ap, fmt);
+    fprintf(stderr, "host: ");
+    vfprintf(stderr, fmt, ap);
+    fprintf(stderr, " (at %.6f s simulated)\n", hostSeconds(cyc));
+    va_end(ap);
+    exit(2);
+}
+
+//-------------- PCD8544
+
+//-- RAM content after VCC comes up is whatever the cells settle to
+static unsigned char hostLcdNoise(void){
+    lcdSeed = lcdSeed * 1103515245UL + 12345UL;
+    return (unsigned char)(lcdSeed >> 16);
+}
+
+//-- state after RST' per the datasheet. the RAM is not touched
+static void hostLcdReset(void){
+    hostLcd.pd = 1;
+    hostLcd.v = 0;
+    hostLcd.h = 0;
+    hostLcd.x = 0;
+    hostLcd.y = 0;
+    hostLcd.mode = 0;
+    hostLcd.vop = 0;
+}
+
+//-- follows VCC (P2.6) and RST' (P2.3). an undriven pin reads as low
+static void hostLcdPins(void){
+    unsigned char vcc = (P2DIR & BIT6) && (p2Out & BIT6);
+    unsigned char rst = (P2DIR & BIT3) && (p2Out & BIT3);
+    int x, b;
+
+    if (!vcc){
+        hostLcd.powered = 0;
+        hostLcd.reset = 0;
+        return;
+    }
+    if (!hostLcd.powered){
+        hostLcd.powered = 1;
+        hostLcd.reset = 0;
+        for (x = 0; x < HOST_LCD_COLS; x++)
+            for (b = 0; b < HOST_LCD_BANKS; b++)
+                hostLcd.ram[x][b] = hostLcdNoise();
+        hostLcdReset();
+    }
+    if (!rst){
+        lcdRstLow = 1;
+        hostLcd.reset = 0;
+        hostLcdReset();
+    }
+    else if (lcdRstLow){
+        lcdRstLow = 0;
+        hostLcd.reset = 1;
+    }
+}
+
+//-- one byte at the last SCLK edge
+static void hostLcdLatch(unsigned char b, unsigned char sceHigh, unsigned char dc){
+    if (sceHigh || !hostLcd.powered || !hostLcd.reset){
+        hostLcd.lostBytes++;
+        return;
+    }
+    if (dc){
+        hostLcd.dataBytes++;
+        hostLcd.ram[hostLcd.x][hostLcd.y] = b;
+        if (!hostLcd.v){
+            if (++hostLcd.x >= HOST_LCD_COLS){
+                hostLcd.x = 0;
+                if (++hostLcd.y >= HOST_LCD_BANKS)
+                    hostLcd.y = 0;
+            }
+        }
+        else if (++hostLcd.y >= HOST_LCD_BANKS){
+            hostLcd.y = 0;
+            if (++hostLcd.x >= HOST_LCD_COLS)
+                hostLcd.x = 0;
+        }
+        return;
+    }
+
+    hostLcd.cmdBytes++;
+    if ((b & 0xF8) == 0x20){                    // function set, both instruction sets
+        hostLcd.pd = (b >> 2) & 1;
+        hostLcd.v = (b >> 1) & 1;
+        hostLcd.h = b & 1;
+    }
+    else if (!hostLcd.h){
+        if (b & 0x80){
+            if ((b & 0x7F) < HOST_LCD_COLS)
+                hostLcd.x = b & 0x7F;
+        }
+        else if ((b & 0xC0) == 0x40){
+            if ((b & 0x07) < HOST_LCD_BANKS)
+                hostLcd.y = b & 0x07;
+        }
+        else if ((b & 0xF8) == 0x08)
+            hostLcd.mode = ((b >> 1) & 2) | (b & 1);
+    }
+    else if (b & 0x80)
+        hostLcd.vop = b & 0x7F;
+}
+
+//-------------- USCI_B1 SPI
+
+static unsigned long hostSpiDiv(void){
+    unsigned int br = UCB1BR0 | (UCB1BR1 << 8);
+
+    return br ? br : 1;
+}
+
+//-- moves TXBUF into the shift register at cycle at
+static void hostSpiStart(unsigned long long at){
+    if (spi.busy || !spi.full)
+        return;
+    spi.shift = spi.buf;
+    spi.full = 0;
+    spi.busy = 1;
+    spi.sce = P4OUT & SCE;
+    spi.end = at + 8 * hostSpiDiv();
+    ucb1Ifg |= UCTXIFG;
+}
+
+static void hostSpiDone(void){
+    spi.busy = 0;
+    ucb1RxBuf = 0xFF;                           // nothing drives MISO
+    ucb1Ifg |= UCRXIFG;
+    hostLcdLatch(spi.shift, spi.sce || (P4OUT & SCE), (P4OUT & DAT_CMD) != 0);
+    hostSpiStart(spi.end);
+}
+
+static void hostSpiConsume(void){
+    if (ucb1TxBuf == HOST_TXBUF_EMPTY)
+        return;
+    changes++;
+    if (spi.full)
+        hostLcd.overwrites++;
+    spi.buf = (unsigned char)ucb1TxBuf;
+    spi.full = 1;
+    ucb1TxBuf = HOST_TXBUF_EMPTY;
+    ucb1Ifg &= ~UCTXIFG;
+    hostSpiStart(cyc);
+}
+
+//-------------- USCI_A1 UART
+
+//-- bit time in 1/16 BRCLK cycles from UCA1BRx and UCA1MCTL, as the family user guide defines it
+static unsigned long hostUartBit16(void){
+    unsigned long br = UCA1BR0 | (UCA1BR1 << 8);
+    unsigned long brs = (UCA1MCTL >> 1) & 7;
+    unsigned long brf = (UCA1MCTL >> 4) & 15;
+
+    if (UCA1MCTL & UCOS16)
+        return 256 * br + 16 * brf + 2 * brs;
+    return 16 * br + 2 * brs;
+}
+
+static unsigned int hostUartFrameBits(void){
+    return 1 + ((UCA1CTL0 & UC7BIT) ? 7 : 8) + ((UCA1CTL0 & UCPEN) ? 1 : 0) + ((UCA1CTL0 & UCSPB) ? 2 : 1);
+}
+
+static void hostUartStart(unsigned long long at){
+    unsigned long long t16;
+
+    if (utx.busy || !utx.full)
+        return;
+    utx.shift = utx.buf;
+    utx.full = 0;
+    utx.busy = 1;
+    t16 = (unsigned long long)hostUartFrameBits() * hostUartBit16() + utx.frac;
+    utx.end = at + t16 / 16;
+    utx.frac = t16 % 16;
+    uca1Ifg |= UCTXIFG;
+}
+
+static void hostUartDone(void){
+    utx.busy = 0;
+    if (txLen + 2 > txCap){
+        txCap = txCap ? txCap * 2 : 4096;
+        txLog = realloc(txLog, txCap);
+        if (!txLog)
+            hostDie("out of memory for the UART log");
+    }
+    txLog[txLen++] = utx.shift;
+    txLog[txLen] = 0;
+    txCount++;
+    if (txEcho)
+        fputc(utx.shift, txEcho);
+    hostUartStart(utx.end);
+}
+
+static void hostUartConsume(void){
+    if (uca1TxBuf == HOST_TXBUF_EMPTY)
+        return;
+    changes++;
+    utx.buf = (unsigned char)uca1TxBuf;
+    utx.full = 1;
+    uca1TxBuf = HOST_TXBUF_EMPTY;
+    uca1Ifg &= ~UCTXIFG;
+    hostUartStart(cyc);
+}
+
+static void hostUartDeliver(void){
+    HOST_RX* rx = &rxQ[rxTail++ % HOST_RX_QUEUE];
+
+    if (uca1Ifg & UCRXIFG){
+        uca1Stat |= UCOE;
+        rxOverruns++;
+    }
+    UCA1RXBUF = rx->ch;
+    uca1Ifg |= UCRXIFG;
+}
+
+//-------------- Timer_B0
+
+static int hostTbRunning(void){
+    return (TB0CTL & 0x0030) != 0;
+}
+
+static unsigned int hostTbShift(void){
+    return (TB0CTL >> 6) & 3;
+}
+
+static unsigned long long hostTbCount(unsigned long long at){
+    return (at - tbBase) >> hostTbShift();
+}
+
+//-- first cycle after tbSeen at which the count reaches ccr
+static unsigned long long hostTbMatch(unsigned int ccr){
+    unsigned long long c = hostTbCount(tbSeen);
+    unsigned long d = (ccr - c) & 0xFFFF;
+
+    if (d == 0)
+        d = 0x10000;
+    return tbBase + ((c + d) << hostTbShift());
+}
+
+static unsigned long long hostTbNext(void){
+    unsigned long long t, next;
+
+    if (!hostTbRunning())
+        return HOST_NEVER;
+    next = tbBase + (((hostTbCount(tbSeen) | 0xFFFF) + 1) << hostTbShift());
+    if (TB0CCTL0 & CCIE){
+        t = hostTbMatch(TB0CCR0);
+        if (t < next)
+            next = t;
+    }
+    if (TB0CCTL1 & CCIE){
+        t = hostTbMatch(TB0CCR1);
+        if (t < next)
+            next = t;
+    }
+    return next;
+}
+
+static void hostTbDue(void){
+    unsigned long long t;
+    unsigned int c;
+
+    while ((t = hostTbNext()) <= cyc){
+        c = (unsigned int)(hostTbCount(t) & 0xFFFF);
+        changes++;
+        if (c == 0)
+            TB0CTL |= TBIFG;
+        if ((TB0CCTL0 & CCIE) && c == TB0CCR0)
+            TB0CCTL0 |= CCIFG;
+        if ((TB0CCTL1 & CCIE) && c == TB0CCR1)
+            TB0CCTL1 |= CCIFG;
+        tbSeen = t;
+    }
+    tbSeen = cyc;
+}
+
+//-------------- event engine
+
+static unsigned long long hostNext(void){
+    unsigned long long next = hostTbNext();
+
+    if (spi.busy && spi.end < next)
+        next = spi.end;
+    if (utx.busy && utx.end < next)
+        next = utx.end;
+    if (rxTail != rxHead && rxQ[rxTail % HOST_RX_QUEUE].at < next)
+        next = rxQ[rxTail % HOST_RX_QUEUE].at;
+    return next;
+}
+
+//-- applies everything scheduled up to now
+static void hostDue(void){
+    int any;
+
+    hostSpiConsume();                           // TXBUF written by an ISR since the last access
+    hostUartConsume();
+    do {
+        any = 0;
+        if (spi.busy && spi.end <= cyc){
+            hostSpiDone();
+            any = 1;
+        }
+        if (utx.busy && utx.end <= cyc){
+            hostUartDone();
+            any = 1;
+        }
+        if (rxTail != rxHead && rxQ[rxTail % HOST_RX_QUEUE].at <= cyc){
+            hostUartDeliver();
+            any = 1;
+        }
+        changes += any;
+    } while (any);
+    hostTbDue();
+}
+
+//-- takes pending interrupts, highest vector first: TIMER0_B0, TIMER0_B1, USCI_A1
+static void hostDispatch(void){
+    void (*isr)(void);
+
+    while ((sr & GIE) && !inIsr){
+        if ((TB0CCTL0 & (CCIE | CCIFG)) == (CCIE | CCIFG)){
+            TB0CCTL0 &= ~CCIFG;                 // single source vector. cleared on entry
+            isr = timerB0TickIsr;
+        }
+        else if ((TB0CTL & (TBIE | TBIFG)) == (TBIE | TBIFG) || (TB0CCTL1 & (CCIE | CCIFG)) == (CCIE | CCIFG))
+            isr = timerB0Isr;
+        else if (UCA1IE & uca1Ifg & (UCRXIE | UCTXIE))
+            isr = USCI_A1_ISR;
+        else
+            break;
+
+        changes++;
+        isrSr = sr;
+        sr &= SCG0;
+        inIsr = 1;
+        isr();
+        inIsr = 0;
+        sr = isrSr;
+    }
+}
+
+//-- catches up with everything the firmware did since the last register access
+static void hostSync(void){
+    if (TB0CTL & TBCLR){
+        TB0CTL &= ~TBCLR;
+        tbBase = cyc;
+        tbSeen = cyc;
+    }
+    hostLcdPins();
+    hostDue();
+    hostDispatch();
+}
+
+//-- a register access with side effects (a write, an IV read, a pin change)
+static void hostAccess(void){
+    pollReg = 0;
+    hostSync();
+}
+
+//-- a status read. the same register read a third time with nothing changed in between is a
+//-- busy-wait, which ends no sooner than the next event, so the clock jumps there
+static void hostPoll(const volatile void* reg){
+    unsigned long long t;
+
+    hostSync();
+    if (reg != pollReg || changes != pollChanges){
+        pollReg = reg;
+        pollChanges = changes;
+        pollRun = 0;
+    }
+    t = hostNext();
+    if (++pollRun > 2 && t != HOST_NEVER)
+        hostAdvance(t);
+    else if (pollRun > HOST_SPIN_MAX)
+        hostDie("busy-wait that nothing can end");
+    else
+        hostAdvance(cyc + HOST_POLL_CYCLES);
+}
+
+static void hostAdvance(unsigned long long target){
+    unsigned long long t;
+
+    for (;;){
+        hostDue();
+        hostDispatch();
+        t = hostNext();
+        if (t > target)
+            break;
+        if (t > cyc)
+            cyc = t;
+        if (hostSeconds(cyc) > HOST_TIMEOUT_S)
+            hostDie("time limit. the firmware never finished");
+    }
+    if (target > cyc)
+        cyc = target;
+}
+
+//-- anything left that can raise an interrupt and end LPM0 (or finish queued output)
+static int hostWakeable(void){
+    return rxTail != rxHead || (TB0CCTL0 & CCIE) || (TB0CCTL1 & CCIE) || utx.busy || utx.full;
+}
+
+static void hostSleep(void){
+    unsigned long long t;
+
+    while (sr & CPUOFF){
+        if (!(sr & GIE))
+            hostDie("LPM0 with interrupts disabled");
+        if (!hostWakeable()){
+            if (idleArmed){
+                sr &= ~CPUOFF;
+                longjmp(idleJmp, 1);
+            }
+            hostDie("asleep and nothing can wake the CPU");
+        }
+        t = hostNext();
+        if (t == HOST_NEVER)
+            hostDie("asleep waiting on a timer that is stopped");
+        sleepCyc += t - cyc;
+        cyc = t;
+        if (hostSeconds(cyc) > HOST_TIMEOUT_S)
+            hostDie("time limit while asleep. the wake-up never came");
+        hostDue();
+        hostDispatch();
+    }
+    wakeups++;
+}
+
+//-------------- register access functions (see msp430.h)
+
+volatile unsigned char* hostRegP2Out(void){
+    hostAccess();
+    return &p2Out;
+}
+
+volatile unsigned char* hostRegUcb1Ifg(void){
+    hostPoll(&ucb1Ifg);
+    return &ucb1Ifg;
+}
+
+volatile unsigned char* hostRegUcb1Stat(void){
+    hostPoll(&ucb1Stat);
+    ucb1Stat = (ucb1Stat & ~UCBUSY) | ((spi.busy || spi.full) ? UCBUSY : 0);
+    return &ucb1Stat;
+}
+
+volatile unsigned int* hostRegUcb1TxBuf(void){
+    hostAccess();
+    return &ucb1TxBuf;
+}
+
+volatile unsigned char* hostRegUcb1RxBuf(void){
+    hostAccess();
+    ucb1Ifg &= ~UCRXIFG;
+    return &ucb1RxBuf;
+}
+
+volatile unsigned char* hostRegUca1Ifg(void){
+    hostPoll(&uca1Ifg);
+    return &uca1Ifg;
+}
+
+volatile unsigned char* hostRegUca1Stat(void){
+    hostPoll(&uca1Stat);
+    uca1Stat = (uca1Stat & ~UCBUSY) | ((utx.busy || utx.full) ? UCBUSY : 0);
+    return &uca1Stat;
+}
+
+volatile unsigned int* hostRegUca1TxBuf(void){
+    hostAccess();
+    return &uca1TxBuf;
+}
+
+//-- any access clears the flag it reports, as on the F5xx
+volatile unsigned short* hostRegUca1Iv(void){
+    unsigned char pending;
+
+    hostAccess();
+    pending = uca1Ifg & UCA1IE;
+    if (pending & UCRXIFG){
+        uca1Iv = 2;
+        uca1Ifg &= ~UCRXIFG;
+    }
+    else if (pending & UCTXIFG){
+        uca1Iv = 4;
+        uca1Ifg &= ~UCTXIFG;
+    }
+    else
+        uca1Iv = 0;
+    return &uca1Iv;
+}
+
+//-- the count moves on by itself, so reading it is never a busy-wait
+volatile unsigned short* hostRegTb0R(void){
+    hostAccess();
+    hostAdvance(cyc + HOST_POLL_CYCLES);
+    if (hostTbRunning())
+        tb0R = (unsigned short)hostTbCount(cyc);
+    return &tb0R;
+}
+
+volatile unsigned short* hostRegTb0Iv(void){
+    hostAccess();
+    if ((TB0CCTL1 & (CCIE | CCIFG)) == (CCIE | CCIFG)){
+        tb0Iv = 2;
+        TB0CCTL1 &= ~CCIFG;
+    }
+    else if ((TB0CTL & (TBIE | TBIFG)) == (TBIE | TBIFG)){
+        tb0Iv = 14;
+        TB0CTL &= ~TBIFG;
+    }
+    else
+        tb0Iv = 0;
+    return &tb0Iv;
+}
+
+//-- the supervisors settle at once
+volatile unsigned short* hostRegPmmIfg(void){
+    hostPoll(&pmmIfg);
+    pmmIfg |= SVSMLDLYIFG | SVMLIFG | SVMLVLRIFG;
+    return &pmmIfg;
+}
+
+//-------------- intrinsics
+
+unsigned int __get_SR_register(void){
+    hostPoll(&sr);
+    return sr;
+}
+
+void __bis_SR_register(unsigned int bits){
+    hostAccess();
+    sr |= bits;
+    hostDispatch();
+    if (sr & CPUOFF)
+        hostSleep();
+}
+
+void __bic_SR_register(unsigned int bits){
+    hostAccess();
+    sr &= ~bits;
+}
+
+void __bic_SR_register_on_exit(unsigned int bits){
+    if (!inIsr)
+        hostDie("__bic_SR_register_on_exit outside an ISR");
+    isrSr &= ~bits;
+}
+
+void __enable_interrupt(void){
+    hostAccess();
+    sr |= GIE;
+    hostDispatch();
+}
+
+void __disable_interrupt(void){
+    hostAccess();
+    sr &= ~GIE;
+}
+
+//-- saving SR for a critical section is not a busy-wait, unlike __get_SR_register in a loop
+unsigned short __get_interrupt_state(void){
+    hostAccess();
+    return sr;
+}
+
+void __set_interrupt_state(unsigned short state){
+    hostAccess();
+    sr = (sr & ~GIE) | (state & GIE);
+    hostDispatch();
+}
+
+void __delay_cycles(unsigned long cycles){
+    hostAccess();
+    hostAdvance(cyc + cycles);
+}
+
+void __no_operation(void){
+}
+
+//-------------- test interface
+
+/************************************************************************************
+* Function: hostBoot
+* - the start-up of main.c: clock, LCD, UART, timer, interrupts, command table and scheduler
+* arguments: none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void hostBoot(void){
+    WDTCTL = WDTPW | WDTHOLD;
+    ucsClockInit(UCS_MCLK_HZ);
+    P4OUT &= ~SCE;
+    P4DIR |= SCE + DAT_CMD;
+    P8OUT |= BIT1;
+    P8DIR |= BIT1;
+    usciB1SpiInit(1, 1, 0x02, 0);
+    usciB1SpiSetFreq(LCD_SCLK_MAX_HZ);
+    nokLcdInit();
+    usciA1UartInit();
+    timerB0Init();
+    __enable_interrupt();
+    initNok5110Cmds(hostCmds);
+    schedInit(hostCmds);
+}
+
+static void hostSchedLoop(void){
+    schedStep();
+}
+
+/************************************************************************************
+* Function: hostRunUntilIdle
+* - calls loop over and over until the firmware goes to sleep with nothing left that could
+*   wake it: no received characters queued, no compare interrupt armed, UART output sent
+* arguments: loop - one pass of the firmware main loop
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void hostRunUntilIdle(void (*loop)(void)){
+    if (setjmp(idleJmp) == 0){
+        idleArmed = 1;
+        for (;;)
+            loop();
+    }
+    idleArmed = 0;
+}
+
+/************************************************************************************
+* Function: hostCmd
+* - types line and enter on the terminal, then runs the scheduler until it is idle again
+* arguments: line - command line without the terminator
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void hostCmd(const char* line){
+    hostUartRx(line);
+    hostUartRx("\r");
+    hostRunUntilIdle(hostSchedLoop);
+}
+
+CMD* hostCmdTable(void){
+    return hostCmds;
+}
+
+//-- lets time pass with the CPU awake, interrupts are taken
+void hostRun(unsigned long us){
+    hostAccess();
+    hostAdvance(cyc + (unsigned long long)us * ucsClockSmclkHz() / 1000000UL);
+}
+
+unsigned long long hostCycles(void){
+    return cyc;
+}
+
+unsigned long long hostSleepCycles(void){
+    return sleepCyc;
+}
+
+unsigned long hostWakeups(void){
+    return wakeups;
+}
+
+double hostSeconds(unsigned long long cycles){
+    return (double)cycles / ucsClockSmclkHz();
+}
+
+//-- bytes the panel latched
+unsigned long hostLcdBusBytes(void){
+    return hostLcd.cmdBytes + hostLcd.dataBytes;
+}
+
+//-- queues text on the terminal at the terminal's baud rate, after whatever is already queued
+void hostUartRx(const char* text){
+    unsigned long long charCyc = 10ULL * ucsClockSmclkHz() / rxBaud;
+
+    if (rxLast < cyc)
+        rxLast = cyc;
+    for (; *text; text++){
+        if (rxHead - rxTail == HOST_RX_QUEUE)
+            hostDie("terminal queue full");
+        rxLast += charCyc;
+        rxQ[rxHead % HOST_RX_QUEUE].at = rxLast;
+        rxQ[rxHead % HOST_RX_QUEUE].ch = (unsigned char)*text;
+        rxHead++;
+    }
+}
+
+//-- idle line time before the next queued character
+void hostUartRxGap(unsigned long us){
+    if (rxLast < cyc)
+        rxLast = cyc;
+    rxLast += (unsigned long long)us * ucsClockSmclkHz() / 1000000UL;
+}
+
+void hostUartSetBaud(unsigned long baud){
+    rxBaud = baud;
+}
+
+unsigned long hostUartRxOverruns(void){
+    return rxOverruns;
+}
+
+//-- everything the firmware has sent since the last hostUartTxClear
+const char* hostUartTxLog(void){
+    return txLog ? txLog : "";
+}
+
+unsigned long hostUartTxCount(void){
+    return txCount;
+}
+
+void hostUartTxClear(void){
+    txLen = 0;
+    if (txLog)
+        txLog[0] = 0;
+}
+
+void hostUartTxEcho(FILE* out){
+    txEcho = out;
+}
+
+//-- prints one test result. returns ok so a test can stop early
+int hostCheck(int ok, const char* fmt, ...){
+    va_list ap;
+
+    va_start(ap, fmt);
+    printf("%s ", ok ? "ok  " : "FAIL");
+    vprintf(fmt, ap);
+    printf("\n");
+    va_end(ap);
+    if (!ok)
+        failures++;
+    return ok;
+}
+
+//-- exit code for main: 0 when every hostCheck passed
+int hostResult(void){
+    fflush(stdout);
+    return failures ? 1 : 0;
+}
+
+int hostLcdPixel(unsigned char x, unsigned char y){
+    return (hostLcd.ram[x][y / 8] >> (y % 8)) & 1;
+}
+
+//-- bytes where the panel differs from the shadow RAM. meaningful at rotation 0
+int hostLcdShadowDiff(void){
+    int x, b, diff = 0;
+
+    for (x = 0; x < HOST_LCD_COLS; x++)
+        for (b = 0; b < HOST_LCD_BANKS; b++)
+            if (hostLcd.ram[x][b] != nokLcdGetByte(x, b))
+                diff++;
+    return diff;
+}
+
+//-- the panel RAM as a binary PBM, 1 = dark
+void hostLcdWritePbm(const char* path){
+    FILE* f = fopen(path, "wb");
+    int x, y;
+    unsigned char row[(HOST_LCD_COLS + 7) / 8];
+
+    if (!f)
+        hostDie("cannot write %s", path);
+    fprintf(f, "P4\n%d %d\n", HOST_LCD_COLS, HOST_LCD_BANKS * 8);
+    for (y = 0; y < HOST_LCD_BANKS * 8; y++){
+        memset(row, 0, sizeof(row));
+        for (x = 0; x < HOST_LCD_COLS; x++)
+            if (hostLcdPixel(x, y))
+                row[x / 8] |= 0x80 >> (x % 8);
+        fwrite(row, 1, sizeof(row), f);
+    }
+    fclose(f);
+}
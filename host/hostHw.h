@@ -0,0 +1,75 @@
+/*************************************************************************************************
+ * hostHw.h
+ * - C interface file for the host simulation of the peripherals the firmware uses: USCI_B1 SPI
+ *   with a PCD8544 on the other end, USCI_A1 UART with a terminal on the other end, Timer_B0,
+ *   and the interrupt and LPM0 behaviour of the CPU.
+ *   Time is counted in SMCLK cycles and only moves when a peripheral is waited on, polled, or
+ *   the CPU sleeps. Firmware instructions take no time, so every duration measured here is the
+ *   bus and peripheral time: a lower bound for the real board, and the same on every PC.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#ifndef HOSTHW_H_
+#define HOSTHW_H_
+
+#include <stdio.h>
+
+#define HOST_LCD_COLS       84
+#define HOST_LCD_BANKS      6
+#define HOST_POLL_CYCLES    4           // one status register read in a busy-wait loop
+#define HOST_TIMEOUT_S      600         // simulated seconds before a run is declared stuck
+
+// what the PCD8544 has latched. ram is indexed [column][bank] like nokLcdGetByte
+typedef struct HOST_LCD {
+    unsigned char ram[HOST_LCD_COLS][HOST_LCD_BANKS];
+    unsigned char powered;              // VCC (P2.6) high
+    unsigned char reset;                // RST' (P2.3) strobed since VCC came up
+    unsigned char pd;                   // function set: power down
+    unsigned char v;                    // function set: vertical addressing
+    unsigned char h;                    // function set: extended instruction set
+    unsigned char x, y;                 // address counter
+    unsigned char mode;                 // display control: D << 1 | E. 2 is normal, 0 blank
+    unsigned char vop;                  // contrast (extended set)
+    unsigned long cmdBytes;             // bytes latched with D/C' low
+    unsigned long dataBytes;            // bytes latched with D/C' high
+    unsigned long lostBytes;            // shifted with SCE' high, no VCC or no reset
+    unsigned long overwrites;           // TXBUF written while still full
+} HOST_LCD;
+
+extern HOST_LCD hostLcd;
+
+struct CMD;
+
+//-------------- func prototypes-------------
+
+void hostBoot(void);
+void hostCmd(const char* line);
+struct CMD* hostCmdTable(void);
+void hostRunUntilIdle(void (*loop)(void));
+void hostRun(unsigned long us);
+
+unsigned long long hostCycles(void);
+unsigned long long hostSleepCycles(void);
+unsigned long hostWakeups(void);
+double hostSeconds(unsigned long long cycles);
+unsigned long hostLcdBusBytes(void);
+
+void hostUartRx(const char* text);
+void hostUartRxGap(unsigned long us);
+void hostUartSetBaud(unsigned long baud);
+unsigned long hostUartRxOverruns(void);
+const char* hostUartTxLog(void);
+unsigned long hostUartTxCount(void);
+void hostUartTxClear(void);
+void hostUartTxEcho(FILE* out);
+
+int hostCheck(int ok, const char* fmt, ...);
+int hostResult(void);
+
+int hostLcdPixel(unsigned char x, unsigned char y);
+int hostLcdShadowDiff(void);
+void hostLcdWritePbm(const char* path);
+
+#endif /* HOSTHW_H_ */
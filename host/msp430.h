@@ -0,0 +1,170 @@
+/*************************************************************************************************
+ * msp430.h (host)
+ * - stands in for the TI device header when the firmware is built for the PC by host/Makefile.
+ *   Bit values are the MSP430F5529 ones. Plain registers are ordinary variables in hostHw.c.
+ *   Registers the peripherals change on their own (flags, counters, transmit buffers) go through
+ *   an access function so the simulator can catch up to the current time first. The access
+ *   functions return a pointer so the register stays an lvalue (UCA1IFG |= UCTXIFG still works).
+ *   16 bit registers are unsigned short so they wrap like the real ones (int is 32 bits here).
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#ifndef HOST_MSP430_H_
+#define HOST_MSP430_H_
+
+#define BIT0                (0x0001)
+#define BIT1                (0x0002)
+#define BIT2                (0x0004)
+#define BIT3                (0x0008)
+#define BIT4                (0x0010)
+#define BIT5                (0x0020)
+#define BIT6                (0x0040)
+#define BIT7                (0x0080)
+
+//-------------- plain registers. only the firmware writes them
+
+extern volatile unsigned char P2DIR, P4DIR, P4OUT, P4SEL, P6DIR, P6OUT, P8DIR, P8OUT;
+extern volatile unsigned char UCB1CTL0, UCB1CTL1, UCB1BR0, UCB1BR1, UCB1IE;
+extern volatile unsigned char UCA1CTL0, UCA1CTL1, UCA1BR0, UCA1BR1, UCA1MCTL, UCA1RXBUF, UCA1IE;
+extern volatile unsigned short UCB1IV;
+extern volatile unsigned short WDTCTL, SFRIFG1;
+extern volatile unsigned short TB0CTL, TB0CCTL0, TB0CCR0, TB0CCTL1, TB0CCR1;
+extern volatile unsigned short UCSCTL0, UCSCTL1, UCSCTL2, UCSCTL3, UCSCTL4, UCSCTL5, UCSCTL6, UCSCTL7;
+extern volatile unsigned short PMMCTL0, SVSMHCTL, SVSMLCTL;
+
+#define PMMCTL0_L           (((volatile unsigned char*)&PMMCTL0)[0])
+#define PMMCTL0_H           (((volatile unsigned char*)&PMMCTL0)[1])
+
+//-------------- registers the simulator owns. see hostHw.c
+
+volatile unsigned char* hostRegP2Out(void);
+volatile unsigned char* hostRegUcb1Ifg(void);
+volatile unsigned char* hostRegUcb1Stat(void);
+volatile unsigned int* hostRegUcb1TxBuf(void);
+volatile unsigned char* hostRegUcb1RxBuf(void);
+volatile unsigned char* hostRegUca1Ifg(void);
+volatile unsigned char* hostRegUca1Stat(void);
+volatile unsigned int* hostRegUca1TxBuf(void);
+volatile unsigned short* hostRegUca1Iv(void);
+volatile unsigned short* hostRegTb0R(void);
+volatile unsigned short* hostRegTb0Iv(void);
+volatile unsigned short* hostRegPmmIfg(void);
+
+#define P2OUT               (*hostRegP2Out())
+#define UCB1IFG             (*hostRegUcb1Ifg())
+#define UCB1STAT            (*hostRegUcb1Stat())
+#define UCB1TXBUF           (*hostRegUcb1TxBuf())
+#define UCB1RXBUF           (*hostRegUcb1RxBuf())
+#define UCA1IFG             (*hostRegUca1Ifg())
+#define UCA1STAT            (*hostRegUca1Stat())
+#define UCA1TXBUF           (*hostRegUca1TxBuf())
+#define UCA1IV              (*hostRegUca1Iv())
+#define TB0R                (*hostRegTb0R())
+#define TB0IV               (*hostRegTb0Iv())
+#define PMMIFG              (*hostRegPmmIfg())
+
+//-------------- status register and intrinsics
+
+#define GIE                 (0x0008)
+#define CPUOFF              (0x0010)
+#define OSCOFF              (0x0020)
+#define SCG0                (0x0040)
+#define SCG1                (0x0080)
+#define LPM0_bits           (CPUOFF)
+
+unsigned int __get_SR_register(void);
+void __bis_SR_register(unsigned int bits);
+void __bic_SR_register(unsigned int bits);
+void __bic_SR_register_on_exit(unsigned int bits);
+void __enable_interrupt(void);
+void __disable_interrupt(void);
+unsigned short __get_interrupt_state(void);
+void __set_interrupt_state(unsigned short state);
+void __delay_cycles(unsigned long cycles);
+void __no_operation(void);
+
+#define __even_in_range(x, y)   (x)
+#define __interrupt
+
+//-------------- port mapping (P4 selects UCA1 and UCB1 in the default mapping)
+
+#define PM_UCA1TXD          (BIT4)
+#define PM_UCA1RXD          (BIT5)
+
+//-------------- USCI
+
+#define UCSWRST             (0x01)
+#define UCSSEL_2            (0x80)
+#define UCSSEL__SMCLK       (0x80)
+#define UCSYNC              (0x01)
+#define UCMODE_0            (0x00)
+#define UCMST               (0x08)
+#define UC7BIT              (0x10)
+#define UCMSB               (0x20)
+#define UCCKPL              (0x40)
+#define UCCKPH              (0x80)
+#define UCSPB               (0x08)
+#define UCPAR               (0x40)
+#define UCPEN               (0x80)
+#define UCOS16              (0x01)
+#define UCBRS0              (0x02)
+#define UCBRF0              (0x10)
+#define UCBUSY              (0x01)
+#define UCOE                (0x20)
+#define UCFE                (0x40)
+#define UCLISTEN            (0x80)
+#define UCRXIFG             (0x01)
+#define UCTXIFG             (0x02)
+#define UCRXIE              (0x01)
+#define UCTXIE              (0x02)
+
+//-------------- Timer_B
+
+#define TBSSEL__SMCLK       (0x0200)
+#define ID__8               (0x00C0)
+#define MC__CONTINUOUS      (0x0020)
+#define TBCLR               (0x0004)
+#define TBIE                (0x0002)
+#define TBIFG               (0x0001)
+#define CCIE                (0x0010)
+#define CCIFG               (0x0001)
+
+//-------------- PMM, UCS, SFR, watchdog
+
+#define PMMPW_H             (0xA5)
+#define PMMCOREV0           (0x0001)
+#define PMMCOREV_0          (0x0000)
+#define PMMCOREV_3          (0x0003)
+#define SVSMHRRL0           (0x0001)
+#define SVSHRVL0            (0x0100)
+#define SVSHE               (0x0400)
+#define SVMHE               (0x4000)
+#define SVSMLRRL0           (0x0001)
+#define SVSLRVL0            (0x0100)
+#define SVSLE               (0x0400)
+#define SVMLE               (0x4000)
+#define SVSMLDLYIFG         (0x0001)
+#define SVMLIFG             (0x0002)
+#define SVMLVLRIFG          (0x0004)
+
+#define SELREF__REFOCLK     (0x0020)
+#define SELA__REFOCLK       (0x0200)
+#define SELS__DCOCLKDIV     (0x0040)
+#define SELM__DCOCLKDIV     (0x0004)
+#define DCORSEL0            (0x0010)
+#define DCORSEL_3           (0x0030)
+#define DCORSEL_5           (0x0050)
+#define DCORSEL_6           (0x0060)
+#define DCORSEL_7           (0x0070)
+#define FLLD_1              (0x1000)
+#define DCOFFG              (0x0001)
+#define XT1LFOFFG           (0x0002)
+#define XT2OFFG             (0x0008)
+#define OFIFG               (0x0002)
+
+#define WDTPW               (0x5A00)
+#define WDTHOLD             (0x0080)
+
+#endif /* HOST_MSP430_H_ */
@@ -0,0 +1,131 @@
+/*************************************************************************************************
+ * replay.c
+ * - replays a capture dump (see cmdCapture.h) against the simulated peripherals and reports the
+ *   LCD bus bytes and time it takes.
+ *
+ *     replay [-t] session
+ *
+ *   The lines are typed on the simulated terminal at their recorded times, with capture on, as a
+ *   PC sending the session file back to a board would. Then the board's own replay command runs
+ *   them again from the capture ring, back to back, or with -t keeping the recorded gaps.
+ *   Both runs are reported: the first as measured here, the second as the firmware prints it.
+ *   Exits with 1 if the file is not a dump, the ring could not hold the session, or the panel
+ *   does not match the shadow RAM at the end.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+
+#include "cmdCapture.h"
+#include "ucsClock.h"
+#include "usciUart.h"
+#include "hostHw.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REPLAY_LINES_MAX    256
+
+typedef struct REPLAY_LINE {
+    unsigned int dt;                // ms since the previous line
+    char line[BUFF_SZ];
+} REPLAY_LINE;
+
+static REPLAY_LINE session[REPLAY_LINES_MAX];
+
+//-- reads the records between @CAP and @END. returns the number of lines, -1 if it is not a dump
+static int replayLoad(FILE* f){
+    char text[BUFF_SZ + 16];
+    char* end;
+    int n = -1;
+
+    while (fgets(text, sizeof(text), f)){
+        text[strcspn(text, "\r\n")] = 0;
+        if (!strncmp(text, "@CAP", 4))
+            n = 0;
+        else if (n < 0)
+            continue;                           // terminal output before the dump
+        else if (!strncmp(text, "@END", 4))
+            return n;
+        else if (n == REPLAY_LINES_MAX)
+            return -1;
+        else {
+            session[n].dt = (unsigned int)strtoul(text, &end, 10);
+            if (end == text || *end != ' ' || strlen(end + 1) >= BUFF_SZ)
+                return -1;
+            strcpy(session[n++].line, end + 1);
+        }
+    }
+    return -1;                                  // no @END
+}
+
+int main(int argc, char** argv){
+    unsigned long long t0, due, wire;
+    unsigned long bytes0, gaps = 0;
+    unsigned int dropped = 0;
+    const char* p;
+    int timed = 0, n, i;
+    FILE* f;
+
+    if (argc == 3 && !strcmp(argv[1], "-t"))
+        timed = 1;
+    else if (argc != 2){
+        fprintf(stderr, "usage: replay [-t] session\n");
+        return 1;
+    }
+    f = fopen(argv[argc - 1], "r");
+    n = f ? replayLoad(f) : -1;
+    if (f)
+        fclose(f);
+    if (n < 0){
+        fprintf(stderr, "replay: %s is not a capture dump\n", argv[argc - 1]);
+        return 1;
+    }
+
+    hostBoot();
+    hostCmd(CMD21 " " CAPTURE_CLEAR);
+    hostCmd(CMD21 " " CAPTURE_START);
+
+    // each line's enter lands at its recorded time after the first one's, or as soon as the board
+    // is free again
+    t0 = hostCycles();
+    bytes0 = hostLcdBusBytes();
+    for (i = 0; i < n; i++){
+        gaps += session[i].dt;
+        wire = (strlen(session[i].line) + 1) * 10ULL * ucsClockSmclkHz() / UART_BAUD;
+        if (i == 0)
+            due = hostCycles() + wire;
+        due += (unsigned long long)session[i].dt * ucsClockSmclkHz() / 1000;
+        if (hostCycles() + wire < due)
+            hostUartRxGap((unsigned long)((due - wire - hostCycles()) * 1000000ULL / ucsClockSmclkHz()));
+        hostCmd(session[i].line);
+    }
+    printf("%s: %d lines, %lu ms of recorded gaps\n", argv[argc - 1], n, gaps);
+    printf("typed: %.1f ms, %lu bus bytes\n", hostSeconds(hostCycles() - t0) * 1e3, hostLcdBusBytes() - bytes0);
+
+    hostUartTxClear();
+    hostCmd(CMD21);
+    p = strstr(hostUartTxLog(), "\ncapture ");
+    if (!p || sscanf(p + 1, "capture %*s %*u lines %*u/%*u bytes, %u dropped", &dropped) != 1 || dropped){
+        fprintf(stderr, "replay: the capture ring dropped %u of the %d lines\n", dropped, n);
+        return 1;
+    }
+    hostCmd(CMD21 " " CAPTURE_STOP);
+
+    hostUartTxClear();
+    hostCmd(timed ? CMD22 " " REPLAY_TIMED : CMD22);
+    p = strstr(hostUartTxLog(), "\nreplay ");
+    if (!p){
+        fprintf(stderr, "replay: no report from the board\n");
+        return 1;
+    }
+    printf("board:\n%s", p + 1);
+    if (hostLcdShadowDiff()){
+        fprintf(stderr, "replay: the panel does not match the shadow RAM\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,199 @@
+/*************************************************************************************************
+ * snap2pbm.c
+ * - turns a snapshot captured from the UART (format in nokSnapshot.h) into a PBM (P4) image.
+ *
+ *     snap2pbm [-n frame] capture pbm
+ *
+ *   frame counts from 0, the first @SNAP in the capture. capture - reads stdin. Anything around
+ *   the frame (the echoed command, other output) is skipped, so a raw terminal log can be passed
+ *   as is. The encoded byte count and the CRC-16/CCITT-FALSE of the decoded bytes are checked
+ *   before anything is written. Exits with 1 and a message on stderr if the frame is missing,
+ *   truncated or fails a check.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+
+#include "nok5110LCD.h"
+#include "nokSnapshot.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SNAP_TEXT_SZ    256                             // one capture line
+#define SNAP_DIM_MAX    LCD_MAX_COL                     // widest and tallest screen, any rotation
+#define SNAP_BYTES_MAX  (SNAP_DIM_MAX * ((SNAP_DIM_MAX + LCD_ROW_IN_BANK - 1) / LCD_ROW_IN_BANK))
+#define SNAP_PACKED_MAX (2 * SNAP_BYTES_MAX)            // PackBits never doubles the size
+#define SNAP_B64_MAX    (4 * ((SNAP_PACKED_MAX + 2) / 3))
+
+static char b64[SNAP_B64_MAX + 1];
+static unsigned char packed[SNAP_PACKED_MAX];
+static unsigned char banks[SNAP_BYTES_MAX];
+
+//-- prints why the capture is refused. returns 1, the exit status
+static int snapFail(const char* fmt, ...){
+    va_list args;
+
+    va_start(args, fmt);
+    fprintf(stderr, "snap2pbm: ");
+    vfprintf(stderr, fmt, args);
+    fprintf(stderr, "\n");
+    va_end(args);
+    return 1;
+}
+
+//-- CRC-16/CCITT-FALSE: poly 0x1021, init 0xFFFF, no reflection, no final XOR
+static unsigned int snapCrc16(const unsigned char* data, unsigned int n){
+    unsigned int crc = 0xFFFF, i, bit;
+
+    for (i = 0; i < n; i++){
+        crc ^= (unsigned int)data[i] << 8;
+        for (bit = 0; bit < 8; bit++)
+            crc = ((crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1) & 0xFFFF;
+    }
+    return crc;
+}
+
+//-- value of one base64 char, -1 if it is not in the alphabet
+static int snapB64Value(char c){
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    const char* p = c ? strchr(alphabet, c) : 0;
+
+    return p ? (int)(p - alphabet) : -1;
+}
+
+//-- strict base64 decode, '=' only as padding. returns the byte count, -1 if the text is not base64
+static long snapB64Decode(const char* text, unsigned char* out){
+    unsigned long len = strlen(text), i, k, n = 0;
+    unsigned long quad;
+    unsigned int pad = 0;
+    int v;
+
+    if (len % 4)
+        return -1;
+    for (i = 0; i < len; i += 4){
+        for (quad = 0, k = 0; k < 4; k++){
+            if (text[i + k] == '=' && i + 4 == len && k >= 2 && (k == 3 || text[i + 3] == '=')){
+                pad++;
+                v = 0;
+            }
+            else if ((v = snapB64Value(text[i + k])) < 0 || pad)
+                return -1;
+            quad = (quad << 6) | v;
+        }
+        out[n++] = (unsigned char)(quad >> 16);
+        if (pad < 2)
+            out[n++] = (unsigned char)(quad >> 8);
+        if (pad < 1)
+            out[n++] = (unsigned char)quad;
+    }
+    return (long)n;
+}
+
+//-- PackBits as nokSnapshotSend writes it. returns the byte count, -1 on a bad or oversized stream
+static long snapUnpack(const unsigned char* in, long n, unsigned char* out, long max){
+    long i = 0, k = 0, run;
+
+    while (i < n){
+        run = in[i++];
+        if (run < 128){                                 // literal of run + 1 bytes
+            if (i + run + 1 > n || k + run + 1 > max)
+                return -1;
+            memcpy(out + k, in + i, run + 1);
+            i += run + 1;
+            k += run + 1;
+        }
+        else if (run > 128){                            // 257 - run copies of the next byte
+            if (i >= n || k + 257 - run > max)
+                return -1;
+            memset(out + k, in[i++], 257 - run);
+            k += 257 - run;
+        }
+        else
+            return -1;                                  // 128 is not used by the encoder
+    }
+    return k;
+}
+
+int main(int argc, char** argv){
+    unsigned int width = 0, height = 0, crc, want, x, y, row, frame = 0, n = 0, inFrame = 0, found = 0;
+    unsigned long encoded, used = 0;
+    char text[SNAP_TEXT_SZ];
+    long got, done;
+    FILE* f;
+    int a = 1;
+
+    if (argc == 5 && !strcmp(argv[1], "-n")){
+        frame = (unsigned int)strtoul(argv[2], 0, 10);
+        a = 3;
+    }
+    else if (argc != 3){
+        fprintf(stderr, "usage: snap2pbm [-n frame] capture pbm\n");
+        return 1;
+    }
+    f = strcmp(argv[a], "-") ? fopen(argv[a], "r") : stdin;
+    if (!f)
+        return snapFail("cannot open %s", argv[a]);
+
+    while (!found && fgets(text, sizeof(text), f)){
+        text[strcspn(text, "\r\n")] = 0;
+        if (!strncmp(text, "@SNAP", 5)){
+            if (sscanf(text, "@SNAP %u %u", &width, &height) != 2 || !width || !height || width > SNAP_DIM_MAX
+                || height > SNAP_DIM_MAX)
+                return snapFail("bad header: %s", text);
+            inFrame = 1;
+            used = 0;
+        }
+        else if (inFrame && !strncmp(text, "@END", 4)){
+            if (sscanf(text, "@END %lu %x", &encoded, &crc) != 2)
+                return snapFail("bad trailer: %s", text);
+            inFrame = 0;
+            found = n++ == frame;
+        }
+        else if (inFrame){
+            if (used + strlen(text) > SNAP_B64_MAX)
+                return snapFail("%s: frame longer than any screen", argv[a]);
+            strcpy(b64 + used, text);
+            used += strlen(text);
+        }
+    }
+    if (f != stdin)
+        fclose(f);
+    if (inFrame)
+        return snapFail("%s: frame has no @END, capture cut short?", argv[a]);
+    if (!found)
+        return snapFail("%s: no frame %u", argv[a], frame);
+
+    if ((got = snapB64Decode(b64, packed)) < 0)
+        return snapFail("%s: frame is not valid base64", argv[a]);
+    if ((unsigned long)got != encoded)
+        return snapFail("%s: %ld encoded bytes, trailer says %lu", argv[a], got, encoded);
+    want = width * ((height + LCD_ROW_IN_BANK - 1) / LCD_ROW_IN_BANK);
+    if ((done = snapUnpack(packed, got, banks, SNAP_BYTES_MAX)) < 0)
+        return snapFail("%s: PackBits stream is broken", argv[a]);
+    if ((unsigned long)done != want)
+        return snapFail("%s: %ld bytes decoded, a %ux%u screen has %u", argv[a], done, width, height, want);
+    if (snapCrc16(banks, want) != crc)
+        return snapFail("%s: crc %04X, trailer says %04X", argv[a], snapCrc16(banks, want), crc);
+
+    // rows top to bottom, MSB first, 1 = dark, each row padded to a byte
+    if (!(f = fopen(argv[a + 1], "wb")))
+        return snapFail("cannot write %s", argv[a + 1]);
+    fprintf(f, "P4\n%u %u\n", width, height);
+    for (y = 0; y < height; y++){
+        for (row = 0, x = 0; x < width; x++){
+            row = (row << 1) | ((banks[(y / LCD_ROW_IN_BANK) * width + x] >> (y % LCD_ROW_IN_BANK)) & 1);
+            if (x % 8 == 7 || x == width - 1){
+                fputc((row << (7 - x % 8)) & 0xFF, f);
+                row = 0;
+            }
+        }
+    }
+    fclose(f);
+    printf("%s: %ux%u, %lu encoded bytes, crc %04X\n", argv[a + 1], width, height, encoded, crc);
+    return 0;
+}
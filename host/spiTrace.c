@@ -0,0 +1,164 @@
+/*************************************************************************************************
+ * spiTrace.c
+ * - analyses an SPI bus trace exported with "spiTrace dump" (firmware built with
+ *   SPI_TRACE_ENABLE = 1) on the PC, where there is room for more than the device report:
+ *
+ *     spiTrace [-t tb0Hz] [-s sclkHz] dump
+ *
+ *   Prints one line per SCE' frame (bytes, command/data mix, duration, bytes/s), the PCD8544
+ *   commands decoded, and the same totals as the on-device "spiTrace" report so the two can be
+ *   compared. Frames cut by the wrap of the trace buffer are marked partial.
+ *   tb0Hz and sclkHz default to what the firmware runs at with UCS_MCLK_HZ and LCD_SCLK_MAX_HZ.
+ *   Anything in the file that is not a trace line (the echoed command, a prompt) is skipped.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+
+#include "nok5110LCD.h"
+#include "timerB0.h"
+#include "usciSpi.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TRACE_SMCLK_HZ  (UCS_MCLK_HZ / 32768 * 32768)   // ucsClockInit rounds down to the FLL reference
+#define TRACE_LINE_SZ   64
+
+// PCD8544 command decode, H is the instruction set chosen by the last function set
+#define PCD_FUNCTION_SET    0x20        // 0010 0PVH
+#define PCD_FUNCTION_H      0x01
+#define PCD_SET_Y           0x40        // basic set: 0100 0yyy
+#define PCD_SET_X           0x80        // basic set: 1xxx xxxx
+#define PCD_DISPLAY_CTL     0x08        // basic set: 0000 1D0E
+#define PCD_SET_VOP         0x80        // extended set: 1vvv vvvv
+#define PCD_BIAS            0x10        // extended set: 0001 0bbb
+#define PCD_TEMP_COEF       0x04        // extended set: 0000 01tt
+
+typedef struct TRACE_ENTRY {
+    unsigned long dt;                   // TB0 ticks since the previous byte, 0xFFFF unknown
+    unsigned char dc, byte, csLow, csHigh;
+} TRACE_ENTRY;
+
+static TRACE_ENTRY trace[SPI_TRACE_SZ];
+
+//-- one PCD8544 command as text
+static const char* traceDecode(unsigned char b, unsigned char* h){
+    if ((b & 0xF8) == PCD_FUNCTION_SET){
+        *h = b & PCD_FUNCTION_H;
+        return "function set";
+    }
+    if (*h){
+        if (b & PCD_SET_VOP) return "set Vop";
+        if ((b & 0xF8) == PCD_BIAS) return "bias";
+        if ((b & 0xFC) == PCD_TEMP_COEF) return "temp coefficient";
+    }
+    else {
+        if (b & PCD_SET_X) return "set X";
+        if ((b & 0xF8) == PCD_SET_Y) return "set Y";
+        if ((b & 0xFA) == PCD_DISPLAY_CTL) return "display control";
+    }
+    return b ? "other" : "nop";
+}
+
+int main(int argc, char** argv){
+    static const char* const names[] = { "function set", "set X", "set Y", "display control", "set Vop", "bias",
+                                         "temp coefficient", "nop", "other" };
+    unsigned long cmdCount[sizeof(names) / sizeof(names[0])] = { 0 };
+    unsigned long tb0Hz = TRACE_SMCLK_HZ / TIMERB0_DIV;
+    unsigned long sclkHz = TRACE_SMCLK_HZ / ((TRACE_SMCLK_HZ + LCD_SCLK_MAX_HZ - 1) / LCD_SCLK_MAX_HZ);
+    unsigned long byteTicks, active = 0, frameTicks = 0, n = 0, nCmd = 0, nCs = 0, nIdle = 0, nGaps = 0, frames = 0;
+    unsigned long fBytes = 0, fCmd = 0, i, k;
+    char text[TRACE_LINE_SZ], dc, flags[3];
+    unsigned int dt, byte;
+    unsigned char h = 0;
+    const char* what;
+    FILE* f;
+    int a;
+
+    for (a = 1; a + 1 < argc && argv[a][0] == '-'; a += 2){
+        if (!strcmp(argv[a], "-t"))
+            tb0Hz = strtoul(argv[a + 1], 0, 10);
+        else if (!strcmp(argv[a], "-s"))
+            sclkHz = strtoul(argv[a + 1], 0, 10);
+        else
+            break;
+    }
+    if (a != argc - 1 || !tb0Hz || !sclkHz){
+        fprintf(stderr, "usage: spiTrace [-t tb0Hz] [-s sclkHz] dump\n");
+        return 1;
+    }
+    if (!(f = fopen(argv[a], "r"))){
+        fprintf(stderr, "spiTrace: cannot open %s\n", argv[a]);
+        return 1;
+    }
+    while (n < SPI_TRACE_SZ && fgets(text, sizeof(text), f))
+        if (sscanf(text, "%u %c %2x %2[-LH]", &dt, &dc, &byte, flags) == 4 && (dc == 'C' || dc == 'D')){
+            trace[n].dt = dt;
+            trace[n].dc = dc == 'D';
+            trace[n].byte = (unsigned char)byte;
+            trace[n].csLow = flags[0] == 'L';
+            trace[n].csHigh = flags[1] == 'H';
+            n++;
+        }
+    fclose(f);
+    if (n == 0){
+        fprintf(stderr, "spiTrace: no trace lines in %s\n", argv[a]);
+        return 1;
+    }
+
+    // 8 SCLKs in TB0 ticks, as the device report counts it
+    byteTicks = (unsigned long)((8ULL * tb0Hz + sclkHz / 2) / sclkHz);
+    if (byteTicks == 0)
+        byteTicks = 1;
+
+    printf("%5s %6s %5s %5s %10s %10s\n", "frame", "bytes", "cmd", "data", "us", "B/s");
+    for (i = 0; i < n; i++){
+        if (i != 0){
+            if (trace[i].dt > SPI_TRACE_IDLE_TICKS)
+                nIdle++;
+            else {
+                active += trace[i].dt;
+                nGaps++;
+            }
+        }
+        if (i != 0 && !trace[i].csLow)
+            frameTicks += trace[i].dt;
+        fBytes++;
+        nCs += trace[i].csLow + trace[i].csHigh;
+        if (!trace[i].dc){
+            nCmd++;
+            fCmd++;
+            what = traceDecode(trace[i].byte, &h);
+            for (k = 0; strcmp(names[k], what); k++);
+            cmdCount[k]++;
+        }
+        if (trace[i].csHigh || i == n - 1){
+            frameTicks += byteTicks;
+            frames++;
+            printf("%5lu %6lu %5lu %5lu %10.1f %10.0f%s\n", frames, fBytes, fCmd, fBytes - fCmd,
+                   frameTicks * 1e6 / tb0Hz, fBytes * (double)tb0Hz / frameTicks,
+                   (frames == 1 && !trace[0].csLow) || !trace[i].csHigh ? " partial" : "");
+            fBytes = fCmd = frameTicks = 0;
+        }
+    }
+
+    printf("commands:");
+    for (k = 0, what = " "; k < sizeof(names) / sizeof(names[0]); k++)
+        if (cmdCount[k]){
+            printf("%s%s %lu", what, names[k], cmdCount[k]);
+            what = ", ";
+        }
+    printf("\n");
+
+    // the device report, worked out the same way
+    printf("bytes %lu cmd %lu dat %lu cs edges %lu idle %lu\n", n, nCmd, n - nCmd, nCs, nIdle);
+    k = nGaps ? active / nGaps : 0;
+    active += (nIdle + 1) * byteTicks;
+    printf("achieved %lu B/s ceiling %lu B/s gap %lu us\n", (unsigned long)((unsigned long long)n * tb0Hz / active),
+           sclkHz / 8, (unsigned long)((unsigned long long)(k > byteTicks ? k - byteTicks : 0) * 1000000UL / tb0Hz));
+    return 0;
+}
@@ -0,0 +1,122 @@
+/*************************************************************************************************
+ * testBaud.c
+ * - host test for ucsBaudCalc. For every SMCLK the FLL can make from the list and every common
+ *   baud rate it prints the register settings and the error, checks the error against one
+ *   worked out again from the register fields alone (family user guide bit timing), and checks
+ *   the simulated UART, programmed by usciA1UartSetBaud, sends at that rate. Also checks the
+ *   DCORSEL range ucsClockInit picks holds the DCO (2 x MCLK) on every part, per the datasheet
+ *   limits, and that 16, 20 and 25 MHz get ranges 6, 7 and 7.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+
+#include "ucsClock.h"
+#include "usciUart.h"
+#include "hostHw.h"
+
+#include <math.h>
+#include <string.h>
+
+#define BAUD_CHARS      64          // characters timed per setting
+
+static const unsigned long smclkReq[] = { UCS_RESET_SMCLK_HZ, 4000000UL, 8000000UL, 12000000UL,
+                                          UCS_MCLK_HZ, 20000000UL, UCS_MAX_HZ };
+// F5529 datasheet per DCORSEL range: fastest fDCO at DCOx = 0 and slowest at DCOx = 31
+static const unsigned long dcoLowHz[8] = { 200000UL, 360000UL, 750000UL, 1510000UL, 3200000UL, 6000000UL,
+                                           10700000UL, 19600000UL };
+static const unsigned long dcoHighHz[8] = { 700000UL, 1470000UL, 3170000UL, 6070000UL, 12300000UL, 23700000UL,
+                                            39000000UL, 60000000UL };
+
+typedef struct DCO_CASE {
+    unsigned long mclkHz;
+    unsigned int range;
+} DCO_CASE;
+
+static const DCO_CASE dcoCases[] = { { 16000000UL, 6 }, { 20000000UL, 7 }, { 25000000UL, 7 } };
+
+static const unsigned long bauds[] = { 1200, 2400, 4800, 9600, 19200, 38400, 57600, 115200, 230400,
+                                       460800, 921600 };
+
+//-- bit time in BRCLK cycles from the register fields
+static double bitClocks(const UART_BAUD_CFG* cfg){
+    if (cfg->os16)
+        return 16.0 * cfg->br + cfg->brf + cfg->brs / 8.0;
+    return cfg->br + cfg->brs / 8.0;
+}
+
+int main(void){
+    UART_BAUD_CFG cfg;
+    unsigned long smclk, worstSmclk = 0, worstBaud = 0;
+    unsigned long long t0;
+    unsigned int i, j, bad = 0, slow = 0, settings = 0;
+    unsigned int range, dcoBad = 0;
+    double ref, eff, sent, worst = 0;
+    char text[BAUD_CHARS + 1];
+
+    hostBoot();
+    memset(text, 'U', BAUD_CHARS);
+    text[BAUD_CHARS] = 0;
+
+    printf("%9s %7s %5s %3s %3s %4s %8s %8s %9s\n", "smclk", "baud", "br", "brs", "brf", "os16",
+           "err %", "ref %", "sent %");
+    for (i = 0; i < sizeof(smclkReq) / sizeof(smclkReq[0]); i++){
+        usciA1UartFlush();
+        smclk = ucsClockInit(smclkReq[i]);
+        range = (UCSCTL1 & DCORSEL_7) / DCORSEL0;
+        if (!(UCSCTL2 & FLLD_1) || 2 * smclk < dcoLowHz[range] || 2 * smclk > dcoHighHz[range]){
+            printf("%9lu DCO %lu Hz not held by DCORSEL_%u\n", smclk, 2 * smclk, range);
+            dcoBad++;
+        }
+        for (j = 0; j < sizeof(bauds) / sizeof(bauds[0]); j++){
+            if (ucsBaudCalc(smclk, bauds[j], &cfg)){
+                printf("%9lu %7lu unreachable\n", smclk, bauds[j]);
+                if (smclk >= bauds[j])
+                    bad++;
+                continue;
+            }
+            settings++;
+            eff = smclk / bitClocks(&cfg);
+            ref = (eff - bauds[j]) * 100.0 / bauds[j];
+            if (fabs(ref * 100 - cfg.errBp) > 1.0)
+                bad++;
+            if (fabs(ref) > fabs(worst)){
+                worst = ref;
+                worstSmclk = smclk;
+                worstBaud = bauds[j];
+            }
+
+            // the simulated UART shifts each bit in the time the registers give
+            usciA1UartSetBaud(bauds[j]);
+            t0 = hostCycles();
+            usciA1UartTxString(text);
+            usciA1UartFlush();
+            sent = BAUD_CHARS * 10.0 / hostSeconds(hostCycles() - t0);
+            sent = (sent - bauds[j]) * 100.0 / bauds[j];
+            if (fabs(sent - ref) > 0.05)
+                slow++;
+
+            printf("%9lu %7lu %5u %3u %3u %4u %8.2f %8.2f %9.2f\n", smclk, bauds[j], cfg.br, cfg.brs, cfg.brf,
+                   cfg.os16, cfg.errBp / 100.0, ref, sent);
+        }
+    }
+
+    hostCheck(bad == 0, "errBp matches the error from the register fields for all %u settings", settings);
+    hostCheck(slow == 0, "the UART sends at the computed rate for all %u settings", settings);
+    hostCheck(dcoBad == 0, "every SMCLK has its DCO inside the guaranteed span of its DCORSEL range");
+    for (i = 0; i < sizeof(dcoCases) / sizeof(dcoCases[0]); i++){
+        ucsClockInit(dcoCases[i].mclkHz);
+        range = (UCSCTL1 & DCORSEL_7) / DCORSEL0;
+        hostCheck(range == dcoCases[i].range, "%lu Hz: DCORSEL_%u, expected DCORSEL_%u", dcoCases[i].mclkHz, range,
+                  dcoCases[i].range);
+    }
+    hostCheck(ucsBaudCalc(1000000UL, 2000000UL, &cfg) == -1, "a rate above BRCLK is rejected");
+    hostCheck(ucsBaudCalc(1000000UL, 0, &cfg) == -1, "baud 0 is rejected");
+    printf("largest error %.2f %% at %lu baud from %lu Hz\n", worst, worstBaud, worstSmclk);
+
+    ucsClockInit(UCS_MCLK_HZ);
+    usciA1UartSetBaud(UART_BAUD);
+    return hostResult();
+}
@@ -0,0 +1,95 @@
+/*************************************************************************************************
+ * testCapture.c
+ * - host test for capture and replay. A session with spriteDemo in it is typed with gaps between
+ *   the lines and captured. The dump has to hold the lines and gaps as sent. A timed replay has
+ *   to finish even though spriteDemo starts and stops the CCR0 tick, take the recorded gaps plus
+ *   the command time, give spriteDemo the tick rate it asked for, and leave no compare armed.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+
+#include "cmdCapture.h"
+#include "hostHw.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define CAP_SLACK_US    1000UL      // ms rounding of the recorded gaps
+
+typedef struct CAP_LINE {
+    unsigned int gapMs;             // idle time on the line before this one
+    const char* line;
+} CAP_LINE;
+
+static const CAP_LINE session[] = {
+    { 0,    CMD2 },
+    { 50,   CMD1 " 0 0 83 47" },
+    { 200,  CMD16 " 20 100" },      // spriteDemo: starts and stops the CCR0 tick
+    { 5,    CMD7 " hi" },
+    { 1500, CMD14 " 0 0 9 9" },     // longer than one CCR1 alarm reaches
+};
+#define CAP_LINES   (sizeof(session) / sizeof(session[0]))
+
+//-- parses the replay report. returns 1 if it is all there
+static int capReport(unsigned int* n, unsigned int* bad, unsigned long* us, unsigned long* work, unsigned long* bytes){
+    const char* p = strstr(hostUartTxLog(), "\nreplay ");    // past the echo
+
+    return p && sscanf(p + 1, "replay %u lines (%u rejected) %lu us, %lu us in commands", n, bad, us, work) == 4
+        && (p = strstr(p, "bus bytes ")) && sscanf(p, "bus bytes %lu", bytes) == 1;
+}
+
+int main(void){
+    unsigned long us, work, bytes, gaps = 0, dumped, fps, tenths;
+    unsigned int i, n, bad, dt, lines;
+    const char* p;
+    char line[64];
+
+    hostBoot();
+    hostCmd(CMD21 " " CAPTURE_CLEAR);
+    hostCmd(CMD21 " " CAPTURE_START);
+    for (i = 0; i < CAP_LINES; i++){
+        hostUartRxGap(session[i].gapMs * 1000UL);
+        hostCmd(session[i].line);
+    }
+    hostCmd(CMD21 " " CAPTURE_STOP);
+
+    // the dump: every line, in order, with gaps of at least the idle time before it
+    hostUartTxClear();
+    hostCmd(CMD21 " " CAPTURE_DUMP);
+    p = strstr(hostUartTxLog(), "@CAP ");
+    hostCheck(p && sscanf(p, "@CAP %u", &lines) == 1 && lines == CAP_LINES, "the dump holds %u lines", CAP_LINES);
+    for (i = 0; p && i < CAP_LINES; i++){
+        p = strchr(p + 1, '\n');
+        if (!p || sscanf(p + 1, "%u %63[^\r\n]", &dt, line) != 2 || strcmp(line, session[i].line) || dt < session[i].gapMs
+            || (i == 0 && dt != 0))
+            break;
+        gaps += dt;
+    }
+    hostCheck(i == CAP_LINES, "the dump gives each line with its gap");
+
+    // back to back, then timed
+    hostUartTxClear();
+    hostCmd(CMD22);
+    hostCheck(capReport(&n, &bad, &us, &work, &bytes) && n == CAP_LINES && bad == 0, "replay reports every line");
+
+    hostUartTxClear();
+    hostCmd(CMD22 " " REPLAY_TIMED);
+    printf("%s", hostUartTxLog());
+    if (!hostCheck(capReport(&n, &bad, &us, &work, &bytes) && n == CAP_LINES && bad == 0, "timed replay finishes"))
+        return hostResult();
+    p = strstr(hostUartTxLog(), "recorded gaps ");
+    hostCheck(p && sscanf(p, "recorded gaps %lu ms", &dumped) == 1 && dumped == gaps, "timed replay waits the %lu ms dumped",
+              gaps);
+    hostCheck(us >= gaps * 1000 && us <= gaps * 1000 + work + CAP_SLACK_US,
+              "%lu us: the gaps plus at most the %lu us spent in commands", us, work);
+    p = strstr(hostUartTxLog(), " frames ");
+    hostCheck(p && sscanf(p, " frames %*u us %lu.%lu fps", &fps, &tenths) == 2 && fps == 100 && tenths == 0,
+              "spriteDemo keeps its 100 Hz tick inside the timed replay");
+    hostCheck(!(TB0CCTL0 & CCIE) && !(TB0CCTL1 & CCIE), "no compare left armed");
+    hostCheck(hostLcdShadowDiff() == 0, "the panel matches the shadow RAM");
+
+    return hostResult();
+}
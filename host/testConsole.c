@@ -0,0 +1,79 @@
+/*************************************************************************************************
+ * testConsole.c
+ * - host benchmark for the text console: runs consoleBench on the simulated bus and prints the
+ *   lines per second and bus bytes per line, with and without scrolling. Checks the time and byte
+ *   count consoleBench reports against the simulator, that the panel ends up holding what the
+ *   shadow RAM does, and that the last line printed is on the row above the blank bottom one.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+
+#include "nokConsole.h"
+#include "nokFont.h"
+#include "usciSpi.h"
+#include "hostHw.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define CON_BENCH_LINES     200
+
+//-- runs consoleBench nLines from a clear screen and checks its report against the simulator
+static void conBench(unsigned int nLines){
+    unsigned long long t0;
+    unsigned long bytes0, n, us, rate, bytes, panel;
+    double took, wire;
+    char cmd[32];
+    const char* p;
+
+    nokConsoleClear();
+    t0 = hostCycles();
+    bytes0 = hostLcd.cmdBytes + hostLcd.dataBytes;
+    sprintf(cmd, "consoleBench %u", nLines);
+    hostUartTxClear();
+    hostCmd(cmd);
+    took = hostSeconds(hostCycles() - t0);
+    panel = hostLcd.cmdBytes + hostLcd.dataBytes - bytes0;
+
+    p = strchr(hostUartTxLog(), '\n');      // past the echo of the command line
+    if (!hostCheck(p && sscanf(p + 1, "%lu lines %lu us %lu lines/s %lu bus bytes", &n, &us, &rate, &bytes) == 4,
+                   "consoleBench %u reports", nLines))
+        return;
+    printf("%4lu lines %8lu us %6lu lines/s %7lu bus bytes %6.1f bytes/line\n", n, us, rate, bytes,
+           (double)bytes / n);
+    wire = bytes * 8.0 / usciB1SpiSclkHz();
+    hostCheck(n == nLines && us >= wire * 1e6 && us <= took * 1e6,
+              "reported %lu us, between the %.0f us of SCLK and the %.0f us the command took", us, wire * 1e6, took * 1e6);
+    hostCheck(bytes == panel, "reported %lu bus bytes, the panel latched %lu", bytes, panel);
+}
+
+int main(void){
+    const unsigned char* glyph;
+    unsigned int i, c, bad = 0;
+    char text[16];
+
+    hostBoot();
+
+    conBench(CON_ROWS - 1);                 // fills the screen, never scrolls
+    conBench(CON_BENCH_LINES);              // scrolls on every line once the screen is full
+    hostCheck(hostLcd.lostBytes == 0 && hostLcd.overwrites == 0, "no bytes lost on the bus");
+    hostCheck(hostLcdShadowDiff() == 0, "the panel matches the shadow RAM");
+
+    // every line ends in '\n', so the last one sits above the blank bottom row
+    sprintf(text, "line %u", CON_BENCH_LINES - 1);
+    for (i = 0; text[i]; i++){
+        glyph = nokFontGlyph(text[i]);
+        for (c = 0; c < NOK_FONT_W; c++)
+            if (hostLcd.ram[i * NOK_FONT_PITCH + c][CON_ROWS - 2] != glyph[c])
+                bad++;
+    }
+    for (i = 0; i < HOST_LCD_COLS; i++)
+        if (hostLcd.ram[i][CON_ROWS - 1] != 0)
+            bad++;
+    hostCheck(bad == 0, "\"%s\" on row %u, bottom row blank", text, CON_ROWS - 2);
+
+    return hostResult();
+}
@@ -0,0 +1,94 @@
+/*************************************************************************************************
+ * testEvents.c
+ * - host test for the event flow: the main loop sleeps in LPM0 until the RX ISR has a whole
+ *   line, characters alone do not wake it, the power report agrees with the time the simulated
+ *   CPU really spent asleep, the CCR0 tick wakes it at its rate and stops when told, and an event
+ *   posted before eventWait is returned without sleeping.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+
+#include "events.h"
+#include "sched.h"
+#include "timerB0.h"
+#include "hostHw.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define EVT_LINES       10
+#define EVT_KEY_US      80000UL     // between two key presses
+#define EVT_TICK_HZ     100
+#define EVT_TICKS       10
+
+//-- one line typed at human speed, enter included
+static void typeLine(const char* line){
+    char key[2] = { 0, 0 };
+
+    for (; *line; line++){
+        key[0] = *line;
+        hostUartRx(key);
+        hostUartRxGap(EVT_KEY_US);
+    }
+    hostUartRx("\r");
+}
+
+static void schedLoop(void){
+    schedStep();
+}
+
+int main(void){
+    unsigned long wakeups, sleptMs, lines;
+    unsigned long long t0, sleep0, sleepBefore;
+    const char* p;
+    unsigned int i;
+
+    hostBoot();
+
+    // typed lines: one wake-up each, asleep nearly all the time in between
+    t0 = hostCycles();
+    sleep0 = hostSleepCycles();
+    wakeups = hostWakeups();
+    for (lines = 0; lines < EVT_LINES; lines++)
+        typeLine("nokLcdDrawLine 0 0 83 47");
+    hostRunUntilIdle(schedLoop);
+    wakeups = hostWakeups() - wakeups;
+    hostCheck(wakeups == EVT_LINES, "%lu wake-ups for %u typed lines", wakeups, EVT_LINES);
+    hostCheck(hostSleepCycles() - sleep0 > (hostCycles() - t0) * 99 / 100, "asleep %.3f of %.3f s",
+              hostSeconds(hostSleepCycles() - sleep0), hostSeconds(hostCycles() - t0));
+
+    // the power report counts the same sleep the simulator saw, up to the wake-up for its own line
+    sleepBefore = hostSleepCycles();
+    hostUartTxClear();
+    hostCmd("power");
+    p = strstr(hostUartTxLog(), "sleep ");
+    hostCheck(p && sscanf(p, "sleep %lu ms", &sleptMs) == 1, "power reports the sleep time");
+    hostCheck(sleptMs + 1 >= hostSeconds(sleepBefore) * 1000 && sleptMs <= hostSeconds(hostSleepCycles()) * 1000 + 1,
+              "reported %lu ms asleep, simulator %.1f to %.1f ms", sleptMs, hostSeconds(sleepBefore) * 1000,
+              hostSeconds(hostSleepCycles()) * 1000);
+
+    // CCR0 tick
+    t0 = hostCycles();
+    wakeups = hostWakeups();
+    timerB0TickStart(EVT_TICK_HZ);
+    for (i = 0; i < EVT_TICKS; i++)
+        eventWait(EVT_TICK);
+    timerB0TickStop();
+    hostCheck(hostWakeups() - wakeups == EVT_TICKS, "%lu wake-ups for %u ticks", hostWakeups() - wakeups, EVT_TICKS);
+    hostCheck(hostSeconds(hostCycles() - t0) > 0.0999 && hostSeconds(hostCycles() - t0) < 0.1001,
+              "%u ticks at %u Hz took %.4f s", EVT_TICKS, EVT_TICK_HZ, hostSeconds(hostCycles() - t0));
+    hostRun(100000);
+    hostCheck(!(eventFlags & EVT_TICK), "no tick after timerB0TickStop");
+
+    // an event that is already pending does not sleep
+    t0 = hostCycles();
+    wakeups = hostWakeups();
+    eventFlags |= EVT_TICK;
+    hostCheck(eventWait(EVT_TICK) == EVT_TICK && hostWakeups() == wakeups && hostCycles() - t0 < 100,
+              "pending event returned without sleeping");
+
+    return hostResult();
+}
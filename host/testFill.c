@@ -0,0 +1,135 @@
+/*************************************************************************************************
+ * testFill.c
+ * - host test for nokLcdFill. Random images of several densities, landscape and portrait,
+ *   4 and 8 connected, set and clear, are filled from a random seed and every pixel is compared
+ *   with a breadth first fill done here on a copy. Dense noise and a comb of narrow teeth push far
+ *   more segments than FILL_STACK_SZ holds, so the rescan after an overflow is covered.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+
+#include "nok5110LCD.h"
+#include "nokFill.h"
+#include "hostHw.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FILL_IMAGES     200         // random images per rotation
+
+static unsigned char img[LCD_MAX_COL][LCD_MAX_COL];     // [x][y], big enough for either rotation
+static unsigned short queue[LCD_MAX_COL * LCD_MAX_ROW][2];
+
+//-- reference fill of img: breadth first over single pixels
+static void refFill(int x, int y, int conn, int colour){
+    int w = nokLcdWidth(), h = nokLcdHeight();
+    int head = 0, tail = 0, dx, dy, nx, ny;
+    unsigned char from = img[x][y];
+
+    if (from == colour)
+        return;
+    img[x][y] = colour;
+    queue[tail][0] = x;
+    queue[tail++][1] = y;
+    while (head < tail){
+        x = queue[head][0];
+        y = queue[head++][1];
+        for (dx = -1; dx <= 1; dx++)
+            for (dy = -1; dy <= 1; dy++){
+                if ((dx == 0 && dy == 0) || (conn == 4 && dx != 0 && dy != 0))
+                    continue;
+                nx = x + dx;
+                ny = y + dy;
+                if (nx < 0 || ny < 0 || nx >= w || ny >= h || img[nx][ny] != from)
+                    continue;
+                img[nx][ny] = colour;
+                queue[tail][0] = nx;
+                queue[tail++][1] = ny;
+            }
+    }
+}
+
+//-- draws img into the shadow RAM
+static void imgDraw(void){
+    int x, y;
+    unsigned char bank, b;
+
+    for (x = 0; x < nokLcdWidth(); x++)
+        for (bank = 0; bank * LCD_ROW_IN_BANK < nokLcdHeight(); bank++){
+            for (b = 0, y = 0; y < LCD_ROW_IN_BANK && bank * LCD_ROW_IN_BANK + y < nokLcdHeight(); y++)
+                b |= img[x][bank * LCD_ROW_IN_BANK + y] << y;
+            nokLcdSetByte(x, bank, b);
+        }
+}
+
+//-- pixels where the shadow RAM differs from img
+static unsigned int imgDiff(void){
+    int x, y;
+    unsigned int bad = 0;
+
+    for (x = 0; x < nokLcdWidth(); x++)
+        for (y = 0; y < nokLcdHeight(); y++)
+            if (nokLcdGetPixel(x, y) != img[x][y])
+                bad++;
+    return bad;
+}
+
+//-- vertical teeth one pixel wide joined along the bottom. each tooth is its own segment
+static void imgComb(void){
+    int x, y;
+
+    for (x = 0; x < nokLcdWidth(); x++)
+        for (y = 0; y < nokLcdHeight(); y++)
+            img[x][y] = (x % 2 == 1 && y < nokLcdHeight() - 1) ? 1 : 0;
+}
+
+int main(void){
+    static const int density[] = { 10, 30, 45, 55 };        // % of pixels set
+    int rot, i, x, y, conn, colour, failed = 0, fills = 0;
+
+    hostBoot();
+    nokLcdDeferFlush(0);
+    srand(7);
+
+    for (rot = 0; rot <= 90; rot += 90){
+        nokLcdSetRotation(rot, 0);
+        for (i = 0; i < FILL_IMAGES; i++){
+            for (x = 0; x < nokLcdWidth(); x++)
+                for (y = 0; y < nokLcdHeight(); y++)
+                    img[x][y] = rand() % 100 < density[i % 4];
+            if (i % 25 == 0)
+                imgComb();
+            conn = (i & 1) ? 8 : 4;
+            colour = (i >> 1) & 1;
+            x = rand() % nokLcdWidth();
+            y = rand() % nokLcdHeight();
+
+            imgDraw();
+            if (nokLcdFill(x, y, conn, colour) != 0)
+                failed++;
+            refFill(x, y, conn, colour);
+            if (imgDiff()){
+                if (failed++ == 0)
+                    printf("first mismatch: rotation %d image %d seed %d,%d conn %d colour %d, %u pixels\n",
+                           rot, i, x, y, conn, colour, imgDiff());
+            }
+            fills++;
+        }
+    }
+    hostCheck(failed == 0, "%d of %d fills match the reference fill", fills - failed, fills);
+
+    // the panel got what the shadow RAM holds
+    nokLcdSetRotation(0, 0);
+    imgComb();
+    imgDraw();
+    nokLcdFlush();
+    nokLcdFill(0, 0, 4, 1);
+    hostCheck(hostLcdShadowDiff() == 0, "the panel matches the shadow RAM after a comb fill");
+    hostCheck(nokLcdFill(-1, 0, 4, 1) == -1 && nokLcdFill(0, 0, 6, 1) == -1, "bad seed and connectivity are rejected");
+
+    return hostResult();
+}
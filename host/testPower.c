@@ -0,0 +1,79 @@
+/*************************************************************************************************
+ * testPower.c
+ * - host test for the PCD8544 power-down and warm resume, and the lcdStartBench numbers on the
+ *   simulated bus. Drawing done while asleep has to reach the panel on resume whether the RAM
+ *   was kept or zeroed, the cold start in the bench has to send what nokLcdInit sends plus the
+ *   image, and the panel has to match the shadow RAM after each start.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+
+#include "nok5110LCD.h"
+#include "hostHw.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//-- random image straight into the shadow RAM
+static void pwrImage(void){
+    unsigned char x, bank;
+
+    for (x = 0; x < LCD_MAX_COL; x++)
+        for (bank = 0; bank < LCD_MAX_BANK; bank++)
+            nokLcdSetByte(x, bank, rand());
+}
+
+int main(void){
+    unsigned long coldUs, keptUs, zeroUs, cold, kept, zeroed, init, bytes0;
+    unsigned int sent;
+    const char* p;
+
+    hostBoot();
+    nokLcdDeferFlush(0);
+    srand(3);
+
+    bytes0 = nokLcdBusBytes();
+    nokLcdInit();
+    init = nokLcdBusBytes() - bytes0;
+    pwrImage();
+    nokLcdFlush();
+
+    // asleep with the RAM kept: only what was drawn meanwhile goes out
+    nokLcdSleep(1);
+    hostCheck(hostLcd.pd, "the panel is powered down");
+    nokLcdDrawLine(0, 0, 83, 47);
+    hostCheck(hostLcdShadowDiff() != 0, "drawing while asleep stays in the shadow RAM");
+    sent = nokLcdResume(1);
+    hostCheck(!hostLcd.pd && hostLcdShadowDiff() == 0, "resume with the RAM kept shows the image (%u bytes)", sent);
+
+    // asleep with the RAM zeroed: the whole image goes out even though VCC never dropped
+    nokLcdSleep(0);
+    nokLcdDrawLine(0, 47, 83, 0);
+    sent = nokLcdResume(1);
+    hostCheck(hostLcdShadowDiff() == 0, "resume after nokLcdSleep(0) shows the image (%u bytes)", sent);
+    hostCheck(hostLcd.lostBytes == 0 && hostLcd.overwrites == 0, "no bytes lost on the bus");
+
+    hostUartTxClear();
+    hostCmd("lcdStartBench");
+    p = strstr(hostUartTxLog(), "cold ");
+    if (!hostCheck(p && sscanf(p, "cold %lu us %lu bytes", &coldUs, &cold) == 2
+                   && (p = strstr(p, "warm, RAM kept ")) && sscanf(p, "warm, RAM kept %lu us %lu bytes", &keptUs, &kept) == 2
+                   && (p = strstr(p, "warm, RAM zeroed ")) && sscanf(p, "warm, RAM zeroed %lu us %lu bytes", &zeroUs, &zeroed) == 2,
+                   "lcdStartBench reports"))
+        return hostResult();
+    printf("%-24s %8s %6s\n", "start", "us", "bytes");
+    printf("%-24s %8lu %6lu\n", "cold (nokLcdInit+image)", coldUs, cold);
+    printf("%-24s %8lu %6lu\n", "warm, RAM kept", keptUs, kept);
+    printf("%-24s %8lu %6lu\n", "warm, RAM zeroed", zeroUs, zeroed);
+    printf("%-24s %8s %6lu\n", "nokLcdInit alone", "", init);
+    hostCheck(cold == init + zeroed - LCD_CONFIG_LEN, "cold start sends nokLcdInit's %lu bytes and the image", init);
+    hostCheck(kept == LCD_CONFIG_LEN, "warm start with nothing drawn sends the configuration only");
+    hostCheck(coldUs > zeroUs && zeroUs > keptUs, "cold slower than warm zeroed slower than warm kept");
+    hostCheck(hostLcdShadowDiff() == 0, "the panel matches the shadow RAM after the bench");
+
+    return hostResult();
+}
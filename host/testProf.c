@@ -0,0 +1,86 @@
+/*************************************************************************************************
+ * testProf.c
+ * - host test for the profiling maths, built with PROF_ENABLE = 1. Known durations are recorded
+ *   straight into one slot and the stats command has to report their count, min, mean and max,
+ *   and p50/p99 as the upper edge of the log2 bucket the rank falls in, clipped to the max.
+ *   Covers samples on bucket edges, the largest tick count (the sum must not wrap), and more
+ *   samples in one bucket than its 16 bit counter holds.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+
+#include "profStats.h"
+#include "timerB0.h"
+#include "hostHw.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define PROF_SLOT_TEST  PROF_SLOT_SETPIXEL      // nothing draws while the test runs
+
+typedef struct PROF_CASE {
+    const char* name;
+    unsigned long count, min, mean, p50, p99, max;  // expected, in ticks
+} PROF_CASE;
+
+//-- reports the test slot and checks it against the expected ticks
+static void profCheck(const PROF_CASE* c){
+    unsigned long n, v[5];
+    const char* p;
+
+    hostUartTxClear();
+    hostCmd(CMD3);
+    p = strstr(hostUartTxLog(), "\nsetPixel ");
+    if (!hostCheck(p && sscanf(p + 1, "setPixel %lu %lu %lu %lu %lu %lu", &n, &v[0], &v[1], &v[2], &v[3], &v[4]) == 6,
+                   "%s: stats reports the slot", c->name))
+        return;
+    printf("%-14s %6lu %10lu %10lu %10lu %10lu %10lu\n", c->name, n, v[0], v[1], v[2], v[3], v[4]);
+    hostCheck(n == c->count && v[0] == timerB0TicksToUs(c->min) && v[1] == timerB0TicksToUs(c->mean)
+              && v[2] == timerB0TicksToUs(c->p50) && v[3] == timerB0TicksToUs(c->p99) && v[4] == timerB0TicksToUs(c->max),
+              "%s: count %lu min %lu mean %lu p50 %lu p99 %lu max %lu us", c->name, c->count, timerB0TicksToUs(c->min),
+              timerB0TicksToUs(c->mean), timerB0TicksToUs(c->p50), timerB0TicksToUs(c->p99), timerB0TicksToUs(c->max));
+}
+
+int main(void){
+    // 100..10000 in steps of 100: rank 50 (5000) ends in bucket 12, rank 99 (9900) in bucket 13
+    static const PROF_CASE ramp = { "ramp", 100, 100, 5050, 8191, 10000, 10000 };
+    // 8 and 16 open buckets 3 and 4
+    static const PROF_CASE edges = { "bucket edges", 20, 8, 12, 15, 16, 16 };
+    // three of the largest count: the sum needs more than 32 bits, the last bucket is open ended
+    static const PROF_CASE big = { "largest ticks", 4, 0, 0xFFFFFFFFUL / 4 * 3 + 2, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL };
+    // 70000 samples in bucket 2 and one outlier: p99 must stay in bucket 2
+    static const PROF_CASE full = { "full bucket", 70001, 5, 5, 7, 7, 1000 };
+    unsigned long i;
+
+    hostBoot();
+    printf("%-14s %6s %10s %10s %10s %10s %10s (us)\n", "case", "n", "min", "mean", "p50", "p99", "max");
+
+    hostCmd(CMD3 " " STATS_RESET);
+    for (i = 1; i <= 100; i++)
+        profStatsRecord(PROF_SLOT_TEST, i * 100);
+    profCheck(&ramp);
+
+    hostCmd(CMD3 " " STATS_RESET);
+    for (i = 0; i < 10; i++){
+        profStatsRecord(PROF_SLOT_TEST, 8);
+        profStatsRecord(PROF_SLOT_TEST, 16);
+    }
+    profCheck(&edges);
+
+    hostCmd(CMD3 " " STATS_RESET);
+    profStatsRecord(PROF_SLOT_TEST, 0);
+    for (i = 0; i < 3; i++)
+        profStatsRecord(PROF_SLOT_TEST, 0xFFFFFFFFUL);
+    profCheck(&big);
+
+    hostCmd(CMD3 " " STATS_RESET);
+    for (i = 0; i < 70000; i++)
+        profStatsRecord(PROF_SLOT_TEST, 5);
+    profStatsRecord(PROF_SLOT_TEST, 1000);
+    profCheck(&full);
+
+    return hostResult();
+}
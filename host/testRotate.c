@@ -0,0 +1,123 @@
+/*************************************************************************************************
+ * testRotate.c
+ * - host test and benchmark for the rotation applied by nokLcdFlush. For all four rotations,
+ *   with and without mirror, it draws a random image, flushes it and checks every panel pixel
+ *   against the mapping worked out independently. Then it times full screen flushes in host CPU
+ *   time, so the cost of the 8x8 transpose shows against rotation 0, and prints the bus bytes per
+ *   frame. The host times include the simulator and vary by machine, compare them with each other
+ *   only. Also checks the console moves its cursor home when a rotation changes its grid.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+
+#include "nok5110LCD.h"
+#include "nokConsole.h"
+#include "nokFont.h"
+#include "hostHw.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define ROT_FRAMES      200         // full screen flushes per timed run
+#define ROT_RUNS        15          // timed runs per mode. the fastest counts, the rest is host noise
+#define ROT_MODES       8           // 4 rotations, each without and with mirror
+
+static const int rotDeg[] = { 0, 90, 180, 270 };
+
+//-- panel pixel showing logical pixel (lx, ly). mirror flips logical x, then the rotation is clockwise
+static void rotMap(int deg, int mirror, int lx, int ly, int* px, int* py){
+    if (mirror)
+        lx = nokLcdWidth() - 1 - lx;
+    switch (deg){
+    case 0:     *px = lx;                   *py = ly;                   break;
+    case 90:    *px = LCD_MAX_COL - 1 - ly; *py = lx;                   break;
+    case 180:   *px = LCD_MAX_COL - 1 - lx; *py = LCD_MAX_ROW - 1 - ly; break;
+    default:    *px = ly;                   *py = LCD_MAX_ROW - 1 - lx; break;
+    }
+}
+
+static double rotNow(void){
+    struct timespec ts;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+//-- host us per full screen flush, every byte changed so every byte is transformed and sent
+static double rotFrames(unsigned int banks){
+    unsigned int frame, bank, x;
+    double t0 = rotNow();
+
+    for (frame = 0; frame < ROT_FRAMES; frame++){
+        for (x = 0; x < nokLcdWidth(); x++)
+            for (bank = 0; bank < banks; bank++)
+                nokLcdSetByte(x, bank, ~nokLcdGetByte(x, bank));
+        nokLcdFlush();
+    }
+    return (rotNow() - t0) * 1e6 / ROT_FRAMES;
+}
+
+int main(void){
+    unsigned int bank, run, bad, banks, mode;
+    int x, y, px, py;
+    unsigned long bytes0, bytes[ROT_MODES];
+    double us, best[ROT_MODES];
+    const unsigned char* glyph;
+
+    hostBoot();
+    nokLcdDeferFlush(0);                    // the scheduler defers flushes between its steps
+    srand(1);
+
+    // every logical pixel lands on the panel pixel the mapping gives
+    for (mode = 0; mode < ROT_MODES; mode++){
+        nokLcdSetRotation(rotDeg[mode / 2], mode % 2);
+        banks = (nokLcdHeight() + LCD_ROW_IN_BANK - 1) / LCD_ROW_IN_BANK;
+        for (x = 0; x < nokLcdWidth(); x++)
+            for (bank = 0; bank < banks; bank++)
+                nokLcdSetByte(x, bank, rand());
+        nokLcdFlush();
+        bad = 0;
+        for (x = 0; x < nokLcdWidth(); x++)
+            for (y = 0; y < nokLcdHeight(); y++){
+                rotMap(rotDeg[mode / 2], mode % 2, x, y, &px, &py);
+                if (hostLcdPixel(px, py) != nokLcdGetPixel(x, y))
+                    bad++;
+            }
+        hostCheck(bad == 0, "%d deg mirror %d: %u of %u pixels misplaced", rotDeg[mode / 2], mode % 2, bad,
+                  LCD_MAX_COL * LCD_MAX_ROW);
+    }
+
+    // the modes take turns in every run so a slow spell on the host hits all of them alike
+    for (run = 0; run < ROT_RUNS; run++)
+        for (mode = 0; mode < ROT_MODES; mode++){
+            nokLcdSetRotation(rotDeg[mode / 2], mode % 2);
+            bytes0 = nokLcdBusBytes();
+            us = rotFrames((nokLcdHeight() + LCD_ROW_IN_BANK - 1) / LCD_ROW_IN_BANK);
+            bytes[mode] = (nokLcdBusBytes() - bytes0) / ROT_FRAMES;
+            if (run == 0 || us < best[mode])
+                best[mode] = us;
+        }
+    printf("%4s %6s %12s %14s %9s\n", "deg", "mirror", "bytes/frame", "host us/frame", "vs 0 deg");
+    for (mode = 0; mode < ROT_MODES; mode++)
+        printf("%4d %6d %12lu %14.2f %8.2fx\n", rotDeg[mode / 2], mode % 2, bytes[mode], best[mode], best[mode] / best[0]);
+    hostCheck(hostLcd.lostBytes == 0 && hostLcd.overwrites == 0, "no bytes lost on the bus");
+
+    // cursor on the last landscape row, then portrait without going through the rotate command
+    nokLcdSetRotation(0, 0);
+    nokConsoleClear();
+    nokConsolePuts("\n\n\n\n\nlast row here");
+    nokLcdSetRotation(90, 0);
+    nokConsolePuts("A");
+    glyph = nokFontGlyph('A');
+    for (bad = 0, x = 0; x < NOK_FONT_W; x++)
+        if (nokLcdGetByte(x, 0) != glyph[x])
+            bad++;
+    hostCheck(bad == 0, "the console starts at home after the grid changed to %ux%u", CON_COLS, CON_ROWS);
+    nokLcdSetRotation(0, 0);
+
+    return hostResult();
+}
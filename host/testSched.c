@@ -0,0 +1,96 @@
+/*************************************************************************************************
+ * testSched.c
+ * - host test for the scheduler queues. The main loop is held off while lines arrive, so the
+ *   UART line queue and then the command queue fill up. Stepping schedStep by hand checks that
+ *   parse runs before render, commands render in the order they arrived, a full command queue
+ *   holds lines back in the UART queue (a stall, no drops), and nothing reaches the panel until
+ *   the flush that SCHED_FLUSH_MAX renders force. The sched report has to agree.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+
+#include "cmdNok5110LCD.h"
+#include "sched.h"
+#include "usciUart.h"
+#include "hostHw.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define SCHED_WIRE_US   100000UL    // longer than 4 lines take on the wire at 19200 baud
+
+// two batches of UART_RX_LINES commands. SCHED_CMD_Q + UART_RX_LINES is SCHED_FLUSH_MAX
+static const char* const batch[2][UART_RX_LINES] = {
+    { CMD14 " 0 0 9 9", CMD1 " 20 0 30 10", CMD7 " hi", CMD14 " 70 30 83 47" },
+    { CMD1 " 0 47 83 0", CMD7 " there", CMD14 " 40 20 45 25", CMD1 " 83 0 0 0" },
+};
+static const int order[2 * UART_RX_LINES] = { FILLRECT_IDX, DRAWLINE_IDX, PRINT_IDX, FILLRECT_IDX,
+                                              DRAWLINE_IDX, PRINT_IDX, FILLRECT_IDX, DRAWLINE_IDX };
+
+//-- the lines arrive at the wire rate while the main loop is busy elsewhere
+static void schedArrive(const char* const* lines){
+    unsigned int i;
+
+    for (i = 0; i < UART_RX_LINES; i++){
+        hostUartRx(lines[i]);
+        hostUartRx("\r");
+    }
+    hostRun(SCHED_WIRE_US);
+}
+
+int main(void){
+    unsigned long bytes0, flushes, forced, stalls;
+    unsigned int i, lines, cmds, dropped, parsed = 0, early = 0, wrong = 0;
+    int idx, rendered = 0;
+    const char* p;
+
+    hostBoot();
+    hostCmd(CMD2);                          // nokLcdClear
+    bytes0 = hostLcd.dataBytes;
+    dropped = usciA1UartRxDropped();
+
+    // first batch waits in the UART queue, parse moves it into the command queue
+    schedArrive(batch[0]);
+    hostCheck(usciA1UartLinesPending() == UART_RX_LINES, "%u lines waiting", usciA1UartLinesPending());
+    for (i = 0; i < SCHED_CMD_Q; i++)
+        parsed += schedStep() == -1;
+    hostCheck(parsed == SCHED_CMD_Q && usciA1UartLinesPending() == 0, "%u steps parsed %u lines", SCHED_CMD_Q, parsed);
+
+    // second batch arrives with the command queue full. render and parse take turns, parse first
+    schedArrive(batch[1]);
+    for (i = 0; i < UART_RX_LINES + SCHED_FLUSH_MAX; i++){
+        idx = schedStep();
+        if (idx == -1)
+            continue;
+        if (idx != order[rendered++])
+            wrong++;
+        if (rendered < SCHED_FLUSH_MAX && hostLcd.dataBytes != bytes0)
+            early++;
+    }
+    hostCheck(rendered == SCHED_FLUSH_MAX && wrong == 0, "%d commands rendered in arrival order", rendered);
+    hostCheck(early == 0, "the panel untouched until the last render");
+    hostCheck(hostLcd.dataBytes != bytes0 && hostLcdShadowDiff() == 0,
+              "render %u forced the flush, the panel matches the shadow RAM", SCHED_FLUSH_MAX);
+    hostCheck(usciA1UartRxDropped() == dropped, "no characters dropped");
+
+    hostUartTxClear();
+    hostCmd(CMD15);                         // sched
+    printf("%s", hostUartTxLog());
+    flushes = forced = stalls = 0;
+    lines = cmds = 0;
+    if ((p = strstr(hostUartTxLog(), "flushes ")))
+        sscanf(p, "flushes %lu (forced %lu)", &flushes, &forced);
+    if ((p = strstr(hostUartTxLog(), "high water: ")))
+        sscanf(p, "high water: lines %u/%*u cmds %u", &lines, &cmds);
+    if ((p = strstr(hostUartTxLog(), "back-pressure stalls ")))
+        sscanf(p, "back-pressure stalls %lu", &stalls);
+    hostCheck(forced == 1, "the report counts %lu forced flush", forced);
+    hostCheck(lines == UART_RX_LINES && cmds == SCHED_CMD_Q, "high water marks at the queue sizes: lines %u cmds %u",
+              lines, cmds);
+    hostCheck(stalls == UART_RX_LINES, "%lu renders ran while a line waited on the full command queue", stalls);
+
+    return hostResult();
+}
@@ -0,0 +1,143 @@
+/*************************************************************************************************
+ * testSnapshot.c
+ * - round trip for the snapshot export. Sends snapshots of a few screens over the simulated
+ *   UART, saves each capture (echo and all, as a terminal would) in obj/, decodes it with
+ *   bin/snap2pbm and compares the image with one written here from the shadow RAM. Prints
+ *   the base64 size against the same bytes sent raw and how long the command takes at
+ *   UART_BAUD. A capture with one character changed has to be refused by the decoder.
+ *   Run from the host directory.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+
+#include "nok5110LCD.h"
+#include "nokConsole.h"
+#include "nokFill.h"
+#include "usciUart.h"
+#include "hostHw.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SNAP_DECODER    "bin/snap2pbm"
+#define SNAP_CMD_SZ     256
+
+//-- the logical screen as a P4 image, the way snap2pbm has to write it
+static void snapExpect(const char* path){
+    FILE* f = fopen(path, "wb");
+    unsigned char w = nokLcdWidth(), h = nokLcdHeight(), x, y, b;
+
+    fprintf(f, "P4\n%u %u\n", w, h);
+    for (y = 0; y < h; y++){
+        for (b = 0, x = 0; x < w; x++){
+            b = (b << 1) | nokLcdGetPixel(x, y);
+            if (x % 8 == 7 || x == w - 1){
+                fputc(b << (7 - x % 8), f);
+                b = 0;
+            }
+        }
+    }
+    fclose(f);
+}
+
+//-- 1 if both files hold the same bytes
+static int snapSame(const char* a, const char* b){
+    FILE* fa = fopen(a, "rb");
+    FILE* fb = fopen(b, "rb");
+    int ca, cb, same = fa && fb;
+
+    while (same && (ca = fgetc(fa)) == (cb = fgetc(fb)) && ca != EOF);
+    same = same && ca == EOF && cb == EOF;
+    if (fa) fclose(fa);
+    if (fb) fclose(fb);
+    return same;
+}
+
+//-- runs the decoder on a capture. returns its exit status
+static int snapDecode(const char* capture, const char* pbm){
+    char cmd[SNAP_CMD_SZ];
+
+    snprintf(cmd, sizeof(cmd), SNAP_DECODER " %s %s >/dev/null 2>&1", capture, pbm);
+    return system(cmd);
+}
+
+//-- snapshot of the current screen through the decoder and back
+static void snapRoundTrip(const char* name){
+    char capture[64], expect[64], decoded[64];
+    unsigned long long t0 = hostCycles();
+    const char* p;
+    unsigned int chars = 0;
+    FILE* f;
+
+    sprintf(capture, "obj/%s.txt", name);
+    sprintf(expect, "obj/%s.expect.pbm", name);
+    sprintf(decoded, "obj/%s.pbm", name);
+
+    hostUartTxClear();
+    hostCmd("snapshot");
+    f = fopen(capture, "w");
+    fputs(hostUartTxLog(), f);
+    fclose(f);
+    snapExpect(expect);
+    remove(decoded);
+
+    // base64 chars between the header and trailer lines
+    for (p = strstr(hostUartTxLog(), "@SNAP"), p = p ? strchr(p, '\n') : 0; p && *p && *p != '@'; p++)
+        if (*p != '\r' && *p != '\n')
+            chars++;
+    printf("%-10s %3ux%-3u %5u %9u %10.1f\n", name, nokLcdWidth(), nokLcdHeight(), chars,
+           4 * ((LCD_MAX_COL * LCD_MAX_BANK + 2) / 3), hostSeconds(hostCycles() - t0) * 1e3);
+    hostCheck(snapDecode(capture, decoded) == 0 && snapSame(decoded, expect), "%s decodes to the shadow RAM", name);
+}
+
+int main(void){
+    unsigned char x, bank;
+    char* corrupt;
+    FILE* f;
+
+    hostBoot();
+    nokLcdDeferFlush(0);
+    printf("%-10s %7s %5s %9s %10s\n", "screen", "size", "chars", "raw chars", "ms");
+
+    // a rectangle, a line and a line of text
+    nokLcdClear();
+    nokLcdFillRect(5, 5, 30, 20, 1);
+    nokLcdDrawLine(0, 47, 83, 0);
+    nokConsolePuts("\n\n\n\nsnapshot test");
+    snapRoundTrip("scene");
+
+    nokLcdClear();
+    snapRoundTrip("blank");
+
+    srand(5);
+    for (x = 0; x < LCD_MAX_COL; x++)
+        for (bank = 0; bank < LCD_MAX_BANK; bank++)
+            nokLcdSetByte(x, bank, rand());
+    nokLcdFlush();
+    snapRoundTrip("noise");
+
+    nokLcdSetRotation(90, 0);
+    nokLcdFillRect(3, 3, 20, 70, 1);
+    nokLcdDrawLine(0, 0, 47, 83);
+    snapRoundTrip("portrait");
+
+    // one base64 char changed in the middle of the capture: the CRC or the length has to catch it
+    f = fopen("obj/portrait.txt", "rb");
+    corrupt = calloc(1, 8192);
+    fread(corrupt, 1, 8191, f);
+    fclose(f);
+    x = strstr(corrupt, "@SNAP") ? 1 : 0;
+    corrupt[strstr(corrupt, "@END") - corrupt - 10] ^= 0x01;
+    f = fopen("obj/corrupt.txt", "wb");
+    fputs(corrupt, f);
+    fclose(f);
+    free(corrupt);
+    hostCheck(x && snapDecode("obj/corrupt.txt", "obj/corrupt.pbm") != 0, "a corrupted capture is refused");
+
+    nokLcdSetRotation(0, 0);
+    return hostResult();
+}
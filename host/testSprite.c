@@ -0,0 +1,101 @@
+/*************************************************************************************************
+ * testSprite.c
+ * - host benchmark for the sprite demo on the simulated bus. Runs spriteDemo at several tick
+ *   rates and prints the frame rate sustained, bus bytes per frame and the bus ceiling. Checks the
+ *   demo keeps up with ticks the bus can carry, the tick is stopped afterwards, the panel matches
+ *   the shadow RAM, hiding the sprites gives back the background exactly, and a zero frame count
+ *   or tick rate is refused.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+
+#include "nok5110LCD.h"
+#include "nokFill.h"
+#include "nokSprite.h"
+#include "timerB0.h"
+#include "hostHw.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define SPRITE_FRAMES   200
+
+static const unsigned int tickHz[] = { 25, 50, 100, 1000, 4000 };
+
+//-- runs spriteDemo and returns the fps it reports, or 0 if it did not report
+static double spriteRun(unsigned int hz, unsigned long* perFrame, unsigned long* busFps){
+    unsigned long frames, us, fps, tenths, full, work, cpuFps;
+    const char* p;
+    char cmd[32];
+
+    sprintf(cmd, "spriteDemo %u %u", SPRITE_FRAMES, hz);
+    hostUartTxClear();
+    hostCmd(cmd);
+    p = strchr(hostUartTxLog(), '\n');      // past the echo
+    if (!p || sscanf(p + 1, "%lu frames %lu us %lu.%lu fps", &frames, &us, &fps, &tenths) != 4)
+        return 0;
+    if (!(p = strstr(p, "per frame: ")) || sscanf(p, "per frame: %lu bus bytes (full screen %lu) %lu us work",
+                                                  perFrame, &full, &work) != 3)
+        return 0;
+    if (!(p = strstr(p, "ceiling: ")) || sscanf(p, "ceiling: bus %lu fps cpu %lu fps", busFps, &cpuFps) != 2)
+        return 0;
+    return fps + tenths / 10.0;
+}
+
+int main(void){
+    static unsigned char shown[LCD_MAX_COL][LCD_MAX_BANK];
+    unsigned long perFrame = 0, busFps = 0;
+    unsigned int i, x, bank, slow = 0, bad = 0;
+    unsigned char w, h;
+    unsigned long period;
+    double fps, expect;
+
+    hostBoot();
+    hostCmd("nokLcdClear");
+
+    printf("%7s %9s %12s %13s\n", "tick Hz", "fps", "bytes/frame", "bus ceiling");
+    for (i = 0; i < sizeof(tickHz) / sizeof(tickHz[0]); i++){
+        fps = spriteRun(tickHz[i], &perFrame, &busFps);
+        if (!hostCheck(fps > 0, "spriteDemo at %u Hz reports", tickHz[i]))
+            continue;
+        printf("%7u %9.1f %12lu %13lu\n", tickHz[i], fps, perFrame, busFps);
+        period = TIMERB0_CLK_HZ / tickHz[i];    // timerB0TickStart clamps the period to 16 bits
+        expect = (double)TIMERB0_CLK_HZ / (period > 0xFFFF ? 0xFFFF : period);
+        if (expect < busFps / 2 && (fps < expect * 0.995 || fps > expect * 1.005))
+            slow++;
+    }
+    hostCheck(slow == 0, "every tick rate below half the bus ceiling sustained");
+    hostCheck(fps < busFps && fps > busFps * 0.95, "a tick above the bus ceiling runs at the rate the bus allows");
+    hostCheck(!(TB0CCTL0 & CCIE), "the tick is stopped after the demo");
+    hostCheck(hostLcd.lostBytes == 0 && hostLcd.overwrites == 0 && hostLcdShadowDiff() == 0,
+              "the panel matches the shadow RAM");
+
+    // hiding every sprite restores the saved bytes. the background must come back exactly
+    nokLcdDeferFlush(0);
+    nokSpriteHideAll();
+    nokSpriteFrame();
+    for (x = 0; x < LCD_MAX_COL; x++)
+        for (bank = 0; bank < LCD_MAX_BANK; bank++)
+            shown[x][bank] = nokLcdGetByte(x, bank);
+    w = nokLcdWidth();
+    h = nokLcdHeight();
+    nokLcdClear();
+    nokLcdFillRect(w / 4, h / 4, w / 2, (3 * h) / 4, 1);
+    nokLcdDrawLine(0, h - 1, w - 1, 0);
+    for (x = 0; x < LCD_MAX_COL; x++)
+        for (bank = 0; bank < LCD_MAX_BANK; bank++)
+            if (shown[x][bank] != nokLcdGetByte(x, bank))
+                bad++;
+    hostCheck(bad == 0, "the background is back after the sprites are hidden (%u bytes differ)", bad);
+
+    hostUartTxClear();
+    hostCmd("spriteDemo 10 0");
+    hostCmd("spriteDemo 0 50");
+    hostCheck(strstr(hostUartTxLog(), "needs frames and tickHz") && !strstr(hostUartTxLog(), "fps"),
+              "zero tickHz and zero frames are refused");
+
+    return hostResult();
+}
@@ -0,0 +1,113 @@
+/*************************************************************************************************
+ * testStrip.c
+ * - host benchmark for the strip chart on the simulated bus. Runs stripBench in scroll and sweep
+ *   mode and prints samples/s and bus bytes per sample. Checks the report against the bytes the
+ *   panel latched, that both modes reach STRIP_MIN_RATE samples/s, and that sweep sends less per
+ *   sample than scroll. Then plots a known sequence past one screen width in each mode and checks
+ *   every column holds the sample it should: oldest on the left when scrolling, written in place
+ *   with a blank gap ahead of the newest when sweeping.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+
+#include "nok5110LCD.h"
+#include "nokStripChart.h"
+#include "hostHw.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define STRIP_SAMPLES   200         // per benchmark run
+#define STRIP_MIN_RATE  200UL       // samples/s both modes have to reach
+#define STRIP_VMAX      100
+#define STRIP_EXTRA     10          // samples plotted past one screen width
+
+static const char* const modes[] = { "scroll", "sweep" };
+
+//-- sample i of the test sequence
+static int stripSample(unsigned int i){
+    return (int)(i * 37 % (STRIP_VMAX + 1));
+}
+
+//-- the row nokStripPush puts v on
+static unsigned char stripRow(int v){
+    return (unsigned char)((long)(STRIP_VMAX - v) * (nokLcdHeight() - 1) / STRIP_VMAX);
+}
+
+//-- 1 if column x is lit exactly from the row of sample i - 1 to the row of sample i
+static int stripColumn(unsigned char x, unsigned int i){
+    unsigned char y, a = stripRow(stripSample(i)), b = i ? stripRow(stripSample(i - 1)) : a;
+    unsigned char lo = a < b ? a : b, hi = a < b ? b : a;
+
+    for (y = 0; y < nokLcdHeight(); y++)
+        if (nokLcdGetPixel(x, y) != (y >= lo && y <= hi))
+            return 0;
+    return 1;
+}
+
+//-- 1 if column x is blank
+static int stripBlank(unsigned char x){
+    unsigned char y;
+
+    for (y = 0; y < nokLcdHeight(); y++)
+        if (nokLcdGetPixel(x, y))
+            return 0;
+    return 1;
+}
+
+int main(void){
+    unsigned long n, us, rate, perSample, bytes, sent[2];
+    unsigned int mode, i, x, w, good;
+    const char* p;
+    char cmd[32];
+
+    hostBoot();
+    printf("%-7s %10s %13s %10s\n", "mode", "samples/s", "bytes/sample", "bus bytes");
+
+    for (mode = STRIP_SCROLL; mode <= STRIP_SWEEP; mode++){
+        sprintf(cmd, "stripInit 0 %d %u", STRIP_VMAX, mode);
+        hostCmd(cmd);
+        sprintf(cmd, "stripBench %u", STRIP_SAMPLES);
+        hostUartTxClear();
+        bytes = hostLcdBusBytes();
+        hostCmd(cmd);
+        bytes = hostLcdBusBytes() - bytes;
+        p = strstr(hostUartTxLog(), "\n");          // past the echo
+        if (!hostCheck(p && sscanf(p + 1, "%lu samples %lu us %lu samples/s %lu bytes/sample", &n, &us, &rate,
+                                   &perSample) == 4 && n == STRIP_SAMPLES, "%s: stripBench reports", modes[mode]))
+            return hostResult();
+        printf("%-7s %10lu %13lu %10lu\n", modes[mode], rate, perSample, bytes);
+        sent[mode] = perSample;
+        hostCheck(perSample == bytes / STRIP_SAMPLES, "%s: %lu bytes/sample as the panel latched", modes[mode],
+                  bytes / STRIP_SAMPLES);
+        hostCheck(rate >= STRIP_MIN_RATE, "%s: %lu samples/s, at least %lu", modes[mode], rate, STRIP_MIN_RATE);
+        hostCheck(hostLcdShadowDiff() == 0, "%s: the panel matches the shadow RAM", modes[mode]);
+    }
+    hostCheck(sent[STRIP_SWEEP] < sent[STRIP_SCROLL], "sweep sends less per sample than scroll");
+
+    // a known sequence, one screen width and then some
+    w = nokLcdWidth();
+    for (mode = STRIP_SCROLL; mode <= STRIP_SWEEP; mode++){
+        nokLcdDeferFlush(0);
+        nokStripInit(0, STRIP_VMAX, mode);
+        for (i = 0; i < w + STRIP_EXTRA; i++)
+            nokStripPlot(stripSample(i));
+
+        good = 0;
+        for (x = 0; x < w; x++){
+            if (mode == STRIP_SCROLL)
+                good += stripColumn(x, i - w + x);              // oldest on the left
+            else if (x == i % w)
+                good += stripBlank(x);                          // the gap ahead of the newest
+            else
+                good += stripColumn(x, x < i % w ? i - i % w + x : i - i % w - w + x);
+        }
+        hostCheck(good == w, "%s: all %u columns hold their sample", modes[mode], w);
+        hostCheck(hostLcdShadowDiff() == 0, "%s: the panel matches the shadow RAM", modes[mode]);
+    }
+
+    return hostResult();
+}
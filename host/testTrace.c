@@ -0,0 +1,127 @@
+/*************************************************************************************************
+ * testTrace.c
+ * - host test for the SPI bus trace, built with SPI_TRACE_ENABLE = 1. Two single byte flushes
+ *   with an idle gap between them are traced: the on-device report has to count the bytes,
+ *   command bytes and SCE' edges the simulated panel latched, one idle period, and the SCLK
+ *   ceiling of the divider in use. The dump is then run through bin/spiTrace, which has to agree
+ *   with the device report, split the trace into the two frames, and give each a duration no
+ *   longer than the flush took. A full screen clear wraps the trace buffer and has to run at the
+ *   SCLK ceiling.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+
+#include "nok5110LCD.h"
+#include "timerB0.h"
+#include "usciSpi.h"
+#include "hostHw.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define TRACE_IDLE_US   5000UL      // well past SPI_TRACE_IDLE_TICKS
+#define TRACE_DUMP      "obj/trace.txt"
+#define TRACE_TEXT_SZ   4096
+
+typedef struct TRACE_REPORT {
+    unsigned int bytes, cmd, dat, cs, idle;
+    unsigned long achieved, ceiling, gap;
+} TRACE_REPORT;
+
+//-- reads the two report lines from text. returns 1 if both are there
+static int traceReport(const char* text, TRACE_REPORT* r){
+    const char* p = strstr(text, "\nbytes ");      // past the echo or the frame table
+
+    return p && sscanf(p + 1, "bytes %u cmd %u dat %u cs edges %u idle %u", &r->bytes, &r->cmd, &r->dat, &r->cs, &r->idle) == 5
+        && (p = strstr(p, "achieved ")) && sscanf(p, "achieved %lu B/s ceiling %lu B/s gap %lu us", &r->achieved,
+                                                  &r->ceiling, &r->gap) == 3;
+}
+
+//-- dumps the trace and runs the analyser on it. returns its output, 0 if it failed
+static const char* traceAnalyse(void){
+    static char out[TRACE_TEXT_SZ];
+    char cmd[128];
+    size_t len;
+    FILE* f;
+
+    hostUartTxClear();
+    hostCmd("spiTrace dump");
+    f = fopen(TRACE_DUMP, "w");
+    fputs(hostUartTxLog(), f);
+    fclose(f);
+    sprintf(cmd, "bin/spiTrace -t %lu -s %lu " TRACE_DUMP, (unsigned long)TIMERB0_CLK_HZ, usciB1SpiSclkHz());
+    if (!(f = popen(cmd, "r")))
+        return 0;
+    len = fread(out, 1, sizeof(out) - 1, f);
+    out[len] = 0;
+    return pclose(f) == 0 ? out : 0;
+}
+
+//-- one byte changed and flushed. returns the simulated time the flush took in us
+static double traceFlush(unsigned char x, unsigned char bank, unsigned char b){
+    unsigned long long t0 = hostCycles();
+
+    nokLcdSetByte(x, bank, b);
+    nokLcdFlush();
+    return hostSeconds(hostCycles() - t0) * 1e6;
+}
+
+int main(void){
+    TRACE_REPORT dev, host;
+    unsigned long bytes0, cmd0;
+    unsigned int frame, fBytes[2], n;
+    double us[2], fUs[2];
+    const char* out;
+    const char* p;
+
+    hostBoot();
+    nokLcdClear();
+
+    hostCmd("spiTrace reset");
+    nokLcdDeferFlush(0);                    // the scheduler defers flushes between commands
+    bytes0 = hostLcdBusBytes();
+    cmd0 = hostLcd.cmdBytes;
+    us[0] = traceFlush(10, 2, 0x55);
+    hostRun(TRACE_IDLE_US);
+    us[1] = traceFlush(20, 3, 0xAA);
+    bytes0 = hostLcdBusBytes() - bytes0;
+    cmd0 = hostLcd.cmdBytes - cmd0;
+
+    hostUartTxClear();
+    hostCmd("spiTrace");
+    printf("%s", hostUartTxLog());
+    if (!hostCheck(traceReport(hostUartTxLog(), &dev), "the device reports the trace"))
+        return hostResult();
+    hostCheck(dev.bytes == bytes0 && dev.cmd == cmd0 && dev.dat == bytes0 - cmd0,
+              "%u bytes, %u commands as the panel latched", dev.bytes, dev.cmd);
+    hostCheck(dev.cs == 4 && dev.idle == 1, "two SCE' frames and one idle period");
+    hostCheck(dev.ceiling == usciB1SpiSclkHz() / 8, "ceiling %lu B/s is SCLK / 8", dev.ceiling);
+    hostCheck(dev.achieved <= dev.ceiling, "achieved %lu B/s within the ceiling", dev.achieved);
+
+    out = traceAnalyse();
+    if (!hostCheck(out && traceReport(out, &host), "bin/spiTrace analyses the dump"))
+        return hostResult();
+    printf("%s", out);
+    hostCheck(!memcmp(&dev, &host, sizeof(dev)), "bin/spiTrace agrees with the device report");
+    for (frame = 0, p = strchr(out, '\n'); p && frame < 2; frame++, p = strchr(p + 1, '\n'))
+        if (sscanf(p + 1, "%*u %u %*u %*u %lf", &fBytes[frame], &fUs[frame]) != 2)
+            break;
+    hostCheck(frame == 2 && fBytes[0] + fBytes[1] == bytes0 && fBytes[0] == fBytes[1], "two frames of %u bytes", fBytes[0]);
+    hostCheck(frame == 2 && fUs[0] <= us[0] && fUs[1] <= us[1], "frames of %.1f and %.1f us, flushes took %.1f and %.1f",
+              fUs[0], fUs[1], us[0], us[1]);
+
+    // longer than the trace buffer: the oldest entries are overwritten, the first frame is cut
+    hostCmd("spiTrace reset");
+    nokLcdDeferFlush(0);
+    nokLcdClear();
+    out = traceAnalyse();
+    n = out && traceReport(out, &host);
+    hostCheck(n && host.bytes == SPI_TRACE_SZ && strstr(out, "partial"), "a clear wraps the %u entry trace", SPI_TRACE_SZ);
+    hostCheck(n && host.achieved * 100 >= host.ceiling * 99, "the clear runs at %lu of %lu B/s", host.achieved,
+              host.ceiling);
+
+    return hostResult();
+}
@@ -0,0 +1,115 @@
+/*************************************************************************************************
+ * testUart.c
+ * - host test for the interrupt driven UART A1 driver: echo and line assembly in the RX ISR,
+ *   the TX ring draining in the background at the wire rate, output started again after the ring
+ *   ran dry, the polled drain with interrupts off, and the RX line queue dropping what does not fit.
+ *   A line typed during a long burst of output has to leave the burst whole and in order, with
+ *   each echo either sent or counted as dropped, and still arrive as a line. One typed while the
+ *   ring drains has room and is echoed in full.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "hostHw.h"
+#include "usciUart.h"
+#include "ucsClock.h"
+
+#define TYPED       "ABCDEFGHIJKLMNOPQRSTUVWXYZ"   // none of these are in the burst
+#define TYPED_LATE  "0123456789"
+#define LATE_US     150000UL                        // past the time the burst is all queued
+
+int main(void){
+    char text[UART_TX_RING_SZ * 3 + 1], rest[sizeof(text)], line[BUFF_SZ];
+    unsigned long long t0;
+    double expect, took;
+    unsigned long n, overruns;
+    unsigned int i, k, echoed, dropped;
+    const char* p;
+
+    hostBoot();
+
+    // RX ISR echoes every character and a line feed after enter
+    hostUartTxClear();
+    hostCmd("sched");
+    hostCheck(strncmp(hostUartTxLog(), "sched\r\n", 7) == 0, "typed line echoed, then the command output");
+
+    // three rings worth of output. usciA1UartTxString returns once the tail fits in the ring
+    memset(text, 'a', sizeof(text) - 1);
+    text[sizeof(text) - 1] = 0;
+    text[sizeof(text) - 2] = 'z';
+    hostUartTxClear();
+    n = hostUartTxCount();
+    t0 = hostCycles();
+    usciA1UartTxString(text);
+    took = hostSeconds(hostCycles() - t0);
+    expect = (sizeof(text) - 1 - UART_TX_RING_SZ) * 10.0 / UART_BAUD;
+    hostCheck(took < expect * 1.05, "TxString blocks only until the rest fits in the ring: %.2f ms (%.2f ms of wire time)",
+              took * 1e3, expect * 1e3);
+    usciA1UartFlush();
+    took = hostSeconds(hostCycles() - t0);
+    expect = (sizeof(text) - 1) * 10.0 / UART_BAUD;
+    hostCheck(hostUartTxCount() - n == sizeof(text) - 1 && strcmp(hostUartTxLog(), text) == 0,
+              "%lu chars sent in order", hostUartTxCount() - n);
+    hostCheck(took > expect * 0.98 && took < expect * 1.02, "drained at the wire rate: %.2f ms for %.2f ms of frames",
+              took * 1e3, expect * 1e3);
+
+    // the TX ISR turned UCTXIE off when the ring ran dry. the next char has to start it again
+    hostUartTxClear();
+    usciA1UartTxString("first");
+    hostRun(10000);
+    usciA1UartTxString("second");
+    hostRun(10000);
+    hostCheck(strcmp(hostUartTxLog(), "firstsecond") == 0, "output resumes after the ring ran dry: \"%s\"", hostUartTxLog());
+
+    // polled drain with GIE clear, as done before interrupts are enabled
+    hostUartTxClear();
+    __disable_interrupt();
+    usciA1UartTxString("polled");
+    usciA1UartFlush();
+    __enable_interrupt();
+    hostCheck(strcmp(hostUartTxLog(), "polled") == 0, "polled drain with interrupts off");
+
+    // a line typed while the main loop is stuck behind a full ring: two producers on the ring
+    for (i = 0; i < sizeof(text) - 1; i++)
+        text[i] = 'a' + i % 26;
+    hostUartTxClear();
+    usciA1UartFlush();
+    dropped = usciA1UartTxDropped();
+    overruns = hostUartRxOverruns();
+    hostUartRx(TYPED "\r");
+    hostUartRxGap(LATE_US);
+    hostUartRx(TYPED_LATE "\r");
+    usciA1UartTxString(text);
+    usciA1UartFlush();
+    hostRun(10000);
+    dropped = usciA1UartTxDropped() - dropped;
+    for (p = hostUartTxLog(), k = 0, echoed = 0; *p; p++){
+        if (strchr(TYPED TYPED_LATE "\r\n", *p))
+            echoed++;
+        else
+            rest[k++] = *p;
+    }
+    rest[k] = 0;
+    n = strlen(TYPED TYPED_LATE) + 4;
+    printf("%u of %lu echoes sent, %u dropped\n", echoed, n, dropped);
+    hostCheck(strcmp(rest, text) == 0, "the burst arrives whole and in order around the echo");
+    hostCheck(echoed + dropped == n, "every echo is sent or counted as dropped");
+    hostCheck(strstr(hostUartTxLog(), TYPED_LATE "\r\n") != 0, "a line typed while the ring drains is echoed in full");
+    hostCheck(usciA1UartLineGet(line) && strcmp(line, TYPED) == 0 && usciA1UartLineGet(line)
+              && strcmp(line, TYPED_LATE) == 0 && hostUartRxOverruns() == overruns, "both lines arrive without an overrun");
+
+    // more lines than the RX queue holds arrive while the main loop is busy
+    hostUartTxClear();
+    hostUartRx("l1\rl2\rl3\rl4\rl5\r");
+    hostRun(10000);
+    hostCheck(usciA1UartLinesPending() == UART_RX_LINES, "%u of 5 lines queued", usciA1UartLinesPending());
+    hostCheck(usciA1UartRxDropped() == 3, "the fifth line dropped and counted (%u chars)", usciA1UartRxDropped());
+    hostCheck(strstr(hostUartTxLog(), "l5") == 0, "dropped characters are not echoed");
+
+    return hostResult();
+}
@@ -0,0 +1,100 @@
+/*************************************************************************************************
+ * testWidget.c
+ * - host benchmark for the retained widgets on the simulated bus. Runs widgetBench and prints
+ *   bus bytes per update against a full redraw of each widget. Checks that every update costs
+ *   less than the redraw, that a widget moved in small steps ends up with the same pixels as one
+ *   set to the final value at once, that bars scale over a range wider than 32767, and that
+ *   an empty range is refused. int is 32 bits here, so the range check guards the scaling but
+ *   cannot show the 16 bit overflow the long casts prevent on the target.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+
+#include "nok5110LCD.h"
+#include "nokWidget.h"
+#include "hostHw.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define WIDGET_UPDATES  50
+#define WIDGET_IDS      4               // the sample dashboard
+#define WIDGET_WIDE     30000           // bar range -WIDGET_WIDE..WIDGET_WIDE
+
+static const char* const names[WIDGET_IDS] = { "hbar", "vbar", "gauge", "number" };
+
+//-- shadow RAM of the whole screen
+static void widgetShadow(unsigned char shadow[LCD_MAX_COL][LCD_MAX_BANK]){
+    unsigned char x, bank;
+
+    for (x = 0; x < LCD_MAX_COL; x++)
+        for (bank = 0; bank < LCD_MAX_BANK; bank++)
+            shadow[x][bank] = nokLcdGetByte(x, bank);
+}
+
+int main(void){
+    static unsigned char stepped[LCD_MAX_COL][LCD_MAX_BANK], direct[LCD_MAX_COL][LCD_MAX_BANK];
+    static const int final[WIDGET_IDS] = { 37, 91, 64, -4096 };
+    unsigned long whole[WIDGET_IDS], tenths[WIDGET_IDS], full[WIDGET_IDS], updates, us;
+    unsigned int i, id, lit, cheap = 0;
+    const char* p;
+    char cmd[32];
+    int v, bar;
+
+    hostBoot();
+
+    sprintf(cmd, "widgetBench %u", WIDGET_UPDATES);
+    hostUartTxClear();
+    hostCmd(cmd);
+    p = hostUartTxLog();
+    for (id = 0; id < WIDGET_IDS; id++){
+        p = strstr(p, names[id]);
+        if (!p || sscanf(p + strlen(names[id]), " %lu.%lu bytes/update, full redraw %lu", &whole[id], &tenths[id],
+                         &full[id]) != 3)
+            break;
+    }
+    if (!hostCheck(id == WIDGET_IDS && (p = strchr(p, '\n')) && sscanf(p + 1, "%lu updates %lu us", &updates, &us) == 2,
+                   "widgetBench reports every widget"))
+        return hostResult();
+
+    printf("%-7s %13s %12s\n", "widget", "bytes/update", "full redraw");
+    for (id = 0; id < WIDGET_IDS; id++){
+        printf("%-7s %11lu.%lu %12lu\n", names[id], whole[id], tenths[id], full[id]);
+        cheap += whole[id] < full[id];
+    }
+    printf("%lu updates in %lu us\n", updates, us);
+    hostCheck(cheap == WIDGET_IDS, "every update sends less than a full redraw");
+    hostCheck(hostLcdShadowDiff() == 0, "the panel matches the shadow RAM");
+
+    // small steps and one jump to the same values give the same pixels
+    nokLcdDeferFlush(0);
+    nokWidgetDashboard();
+    for (id = 0; id < WIDGET_IDS; id++)
+        for (i = 0; i <= WIDGET_UPDATES; i++)
+            nokWidgetSet(id, (int)((long)final[id] * i / WIDGET_UPDATES));
+    widgetShadow(stepped);
+    nokWidgetDashboard();
+    for (id = 0; id < WIDGET_IDS; id++)
+        nokWidgetSet(id, final[id]);
+    widgetShadow(direct);
+    hostCheck(!memcmp(stepped, direct, sizeof(direct)), "stepped updates leave the same pixels as a direct set");
+
+    // a range wider than 32767: v - vMin and vMax - vMin need more than a 16 bit int
+    nokWidgetRemoveAll();
+    nokLcdClear();
+    bar = nokWidgetBar(0, 0, LCD_MAX_COL, 4, -WIDGET_WIDE, WIDGET_WIDE, 0);
+    for (v = -WIDGET_WIDE, i = 0; v <= WIDGET_WIDE && bar >= 0; v += WIDGET_WIDE / 2){
+        nokWidgetSet(bar, v);
+        for (lit = 0; lit < LCD_MAX_COL && nokLcdGetPixel(lit, 0); lit++);
+        i += lit == (unsigned int)(((long)v + WIDGET_WIDE) * LCD_MAX_COL / (2L * WIDGET_WIDE));
+    }
+    hostCheck(i == 5, "a bar over %d..%d has the right length at 5 values", -WIDGET_WIDE, WIDGET_WIDE);
+
+    hostCheck(nokWidgetBar(0, 10, 20, 4, 5, 5, 0) == -1 && nokWidgetGauge(40, 40, 8, 10, -10) == -1,
+              "vMax <= vMin is refused");
+
+    return hostResult();
+}
@@ -1,293 +1,855 @@
-/*************************************************************************************************
- * nok5110LCD.c
- * - C implementation or source file for NOKIA 5110 LCD.
- *
- *  Author: Greg Scutt
- *  Created on: Feb 20th, 2017
- **************************************************************************************************/
-
-// nok5110LCD pin connectivity --> to MSP-EXP430F5529LP EVM.
-//  8-LIGHT  	-->  	no connection necessary
-//  7-SCLK  	-->  	MS430EVM  P4.3 or UCB1CLK
-//  6-DN(MOSI)  -->  	MS430EVM  P4.1 or UCB1SIMO
-//  5-D/C'  	-->  	MS430EVM  P4.2. 	Kept as I/O pin !!
-//  4-RST'  	-->  	MS430EVM  I/O pin of your choice. See 8.1, 8.2, 12.2 in Nokia Datasheet.
-//  3-SCE'  	-->  	MS430EVM  P4.0.  	Kept as I/O pin !!
-//  2-GND  		-->  	MS430EVM or supply VSS
-//  1-VDD  		-->  	MS430EVM or supply 3V3. Consider controlling it with an I/O pin
-
-#include <msp430.h>
-#include <math.h>
-#include "nok5110LCD.h"
-#include "usciSpi.h"
-
-// 2-D 84x6 array that stores the current pixelated state of the display.
-// remember a byte (8 bits) sets 8 vertical pixels in a column allowing 8x6=48 rows
-// note that this array is GLOBAL to this file only. In that way it is protected from access from other functions in files.
-// said another way - it is a private global array with local scope to the file in which the defining declaration exists.
-// we don't want other functions messing with the shadow RAM. This is the reason for static and for its dec/defn in this .c file
-// static here means that it does not have inter-file scope, it is local to this file only. This is a best practice when you want to
-// protect data structures from unwanted access by other functions in other files.
-static unsigned char currentPixelDisplay[LCD_MAX_COL][LCD_MAX_ROW / LCD_ROW_IN_BANK];
-
-
-/************************************************************************************
-* Function: nokLcdInit
-* -
-* argument:
-*   none
-* return: none
-* Author: Greg Scutt
-* Date: Feb 20th, 2017
-* Modified: <date of any mods> usually taken care of by rev control
-************************************************************************************/
-void nokLcdInit(void) {
-    // power-on RST sequence here.  The display is not powered until this sequence occurs.
-    // hold VCC low
-    P2OUT &= ~BIT6;
-    // hold !RES high
-    P2OUT |= BIT3;
-    // set PWR RST pins as outputs
-    P2DIR |= BIT3 + BIT6;
-    // PWR RST Sequence
-    _PWR;   // bring VCC high through P2.6 // #define _PWR P2OUT |= BIT6
-    _RST;   // send reset strobe through P2.3 // #define _RST P2OUT &= ~BIT3; P2OUT |= BIT3
-
-    P4OUT   &=  ~(SCE | DAT_CMD);   // Set DC and CE Low. This should be made a macro.  But is this command necassary? Doesn't nokLcdWrite do it?
-
-    // send initialization sequence to LCD module
-    nokLcdWrite(LCD_EXT_INSTR, DC_CMD);
-    nokLcdWrite(LCD_SET_OPVOLT, DC_CMD);
-    nokLcdWrite(LCD_SET_TEMPCTRL, DC_CMD);
-    nokLcdWrite(LCD_SET_SYSBIAS, DC_CMD);
-    nokLcdWrite(LCD_BASIC_INSTR, DC_CMD);
-    nokLcdWrite(LCD_NORMAL_DISP, DC_CMD);
-
-    nokLcdClear(); // clear the pixel memory and hence the display.
-    /* Sometimes necessary since the pixel ram is not defined after a PWR on and RST. The best practice would be to
-     always clear it so no residual pixels are set. You will sometimes see random pixels set and I think it is from not clearing the memory
-     which must be done manually. Try removing this function to see what happens.*/
-}
-
-/************************************************************************************
-* Function: nokLcdWrite
-* - performs write sequence to send data or command to nokLCD. Calls spiPutChar to transmit serially to nokLCD
-* argument:
-* Arguments: lcdByte - the 8 bit char (data or command) that is written to nokLCD.
-* 			 cmdType - 0 - lcdByte is a cmd,   1 - lcdByte is data.
-* return: none
-* Author: Greg Scutt
-* Date: Feb 20th, 2017
-* Modified: <date of any mods> usually taken care of by rev control
-************************************************************************************/
-void nokLcdWrite(char lcdByte, char cmdType) {
-	// check cmdType and output correct DAT_CMD signal to PORT4 based on it. Use definitions in .h file
-    switch(cmdType){
-        // -- if its a command, issue a 0
-        case DC_CMD:  P4OUT &= ~DAT_CMD;
-                      break;
-        // -- if its data, issue a 1
-        case DC_DAT:  P4OUT |= DAT_CMD;
-                      break;
-
-        default: break;
-    }
-
-    // clear RXIFG by reading RXBUF
-    UCB1RXBUF = 0;
-
-    // activate the SCE  chip select
-    P4OUT &= ~SCE;
-
-    // transmit lcdByte with spiPutChar from Lab 3.  That function must stay in the spi C module.
-    usciB1SpiPutChar(lcdByte);
-
-    // wait for SPI transmission to complete. You need to poll an SPI interrupt flag. Which one RXIFG or TXIFG? Understand why.
-    while (!(UCB1IFG & UCRXIFG)); // When RXIFG == 1, RXBUF has received a complete character
-
-    // when transmission is complete deactivate the SCE */
-    P4OUT |= SCE;
-}
-
-/************************************************************************************
-* Function: nokLcdSetPixel
-* -
-* argument:
-*	xPos - The horizontal pixel location in the domain (0 to 83)
-*	yPos - The vertical pixel location in the domain (0 to 47)
-*
-* return: 0 - pixel was valid and written.  1 - pixel not valid
-* Author: Greg Scutt
-* Date: Feb 20th, 2017
-* Modified: <date of any mods> usually taken care of by rev control
-************************************************************************************/
-unsigned char  nokLcdSetPixel(unsigned char xPos, unsigned char yPos) {
-	unsigned char bank; // a bank is a group of 8 rows, selected by 8 bits in a byte
-
-	// verify pixel position is valid
-	if ((xPos < LCD_MAX_COL) && (yPos < LCD_MAX_ROW)) {
-
-		// if-else statement avoids costly division
-		if (yPos<8) bank = 0;
-		else if (yPos<16) bank = 1;
-		else if (yPos<24) bank = 2;
-		else if (yPos<32) bank = 3;
-		else if (yPos<40) bank = 4;
-		else if (yPos<48) bank = 5;
-
-		// set the x and y RAM address  corresponding to the desired (x,bank) location. this is a command DC_CMD
-		nokLcdWrite(LCD_SET_XRAM | xPos, DC_CMD);
-		nokLcdWrite(LCD_SET_YRAM | bank, DC_CMD);
-
-		// update the pixel being set in currentPixelDisplay array
-		currentPixelDisplay[xPos][bank] |= BIT0 << (yPos % LCD_ROW_IN_BANK); // i.e if yPos = 7 then BIT0 is left shifted 7 positions to be 0x80. nice mod.
-		nokLcdWrite(currentPixelDisplay[xPos][bank], DC_DAT); // write the byte defining a single pixel
-		return 0;
-	}
-	return 1;
-}
-
-/************************************************************************************
-* Function: nokLcdDrawScrnLine
-* - draws either a horizontal or a vertical line on the Nokia display
-*
-* arguments: xCol coordinate
-*            yLine coordinate
-*
-* return: 0 if inputs were valid, -1 if not
-* Author: Marcus Kuhn
-* Date: Mar 11th, 2021
-* Modified: <date of any mods> usually taken care of by rev control
-************************************************************************************/
-int nokLcdDrawScrnLine(int xCol, int yRow, char mode){
-    int valid = 0;
-
-    // --  check if both coordinates are within boundaries
-    if(xCol < LCD_MAX_COL && yRow < LCD_MAX_ROW){
-        if(mode == 'H'){                                    // a mode == 'H' is a horizontal line
-            while(xCol < LCD_MAX_COL)
-                nokLcdSetPixel(xCol++,yRow);         // auto-increment x after each call, until Max is reached
-        }
-        else if (mode == 'V')                               // likewise
-            while(yRow < LCD_MAX_ROW)
-                nokLcdSetPixel(xCol,yRow++);        // auto-increment y after each call, until Max is reached
-        else valid = -1;
-    }else valid = -1;                                       // if x, y or mode are illegal
-
-    return valid;
-}
-
-/************************************************************************************
-* Function: nokLcdDrawLine
-* - draws a line between two coordinates in the Nokia display using Bresenham's line algorithm
-*
-* arguments: (x0, y0) start coordinate
-*            (x1, y1) finish coordinate
-*
-* return: 0 if inputs were valid, -1 if not
-* Author: Marcus Kuhn
-* Date: Mar 20th, 2021
-* Modified: <date of any mods> usually taken care of by rev control
-************************************************************************************/
-int nokLcdDrawLine(int x0, int y0, int x1, int y1){
-    volatile int valid = 0;
-
-    // check if any coordinate is outside display array range
-    if(x0 < LCD_MAX_COL && y0 < LCD_MAX_ROW && x1 < LCD_MAX_COL && y1 < LCD_MAX_ROW){
-        if (abs(y1 - y0) < abs(x1 - x0)){   // absolute change in x is greater than in y
-            if (x0 > x1)
-                plotLineLow(x1, y1, x0, y0);
-            else
-                plotLineLow(x0, y0, x1, y1);
-        }
-        else {
-            if (y0 > y1)
-                plotLineHigh(x1, y1, x0, y0);
-            else
-                plotLineHigh(x0, y0, x1, y1);
-        }
-    } else valid = -1;
-
-    return valid;
-}
-
-/************************************************************************************
-* Function: nokLcdClear
-* - clears all pixels on LCD display. results in blank display.
-* argument:
-*   none
-* return: none
-* Author: Greg Scutt
-* Date: Feb 20th, 2017
-* Modified: <date of any mods> usually taken care of by rev control
-************************************************************************************/
-void nokLcdClear(void) {
-
-    unsigned char bank; // bank (group of 8 rows) on which pixel falls
-    unsigned char x;    // x coordinate to track columns
-
-    // sweep banks (or group of 8 rows)
-    for (bank = 0; bank < 6; bank++) {
-
-        // start in first column of the bank (0, bank)
-        nokLcdWrite(LCD_SET_XRAM | 0, DC_CMD);
-        // start in current bank
-        nokLcdWrite(LCD_SET_YRAM | bank, DC_CMD);
-
-        // sweep columns. X address is auto-incremented by one since V = 0.
-        for (x = 0; x < LCD_MAX_COL; x++) {
-            currentPixelDisplay[x][bank] = 0;       // update pixel display array to keep pixel state current
-            nokLcdWrite(0, DC_DAT);                 // clear all 8 pixels at (x,bank)
-        }
-    }
-}
-
-//-- Bresenham's line algorithm for when dx > dy
-void plotLineLow(int x0, int y0, int x1, int y1){
-    volatile int dx = x1 - x0,
-                 dy = y1 - y0,
-                 yi = 1,
-                 y, x, D;
-
-    if (dy < 0){
-        yi = -1;
-        dy = -dy;
-    }
-
-    D = (2 * dy) - dx;
-    y = y0;
-
-    for (x = 0; x <= x1; x++){
-        nokLcdSetPixel(x, y);
-        if (D > 0){
-            y = y + yi;
-            D = D + (2 * (dy - dx));
-        }else
-            D = D + 2*dy;
-    }
-}
-
-//-- Bresenham's line algorithm for when dy > dx
-void plotLineHigh(int x0, int y0, int x1, int y1){
-    volatile int dx = x1 - x0,
-                 dy = y1 - y0,
-                 xi = 1,
-                 y, x, D;
-
-    if (dx < 0){
-        xi = -1;
-        dx = -dx;
-    }
-
-    D = (2 * dx) - dy;
-    x = x0;
-
-    for (y = y0; y <= y1; y++){
-        nokLcdSetPixel(x, y);
-        if (D > 0){
-            x = x + xi;
-            D = D + (2 * (dx - dy));
-        }else
-            D = D + 2*dx;
-    }
-}
+/*************************************************************************************************
+ * nok5110LCD.c
+ * - C implementation or source file for NOKIA 5110 LCD.
+ *
+ *  Author: Greg Scutt
+ *  Created on: Feb 20th, 2017
+ **************************************************************************************************/
+
+// nok5110LCD pin connectivity --> to MSP-EXP430F5529LP EVM.
+//  8-LIGHT  	-->  	no connection necessary
+//  7-SCLK  	-->  	MS430EVM  P4.3 or UCB1CLK
+//  6-DN(MOSI)  -->  	MS430EVM  P4.1 or UCB1SIMO
+//  5-D/C'  	-->  	MS430EVM  P4.2. 	Kept as I/O pin !!
+//  4-RST'  	-->  	MS430EVM  I/O pin of your choice. See 8.1, 8.2, 12.2 in Nokia Datasheet.
+//  3-SCE'  	-->  	MS430EVM  P4.0.  	Kept as I/O pin !!
+//  2-GND  		-->  	MS430EVM or supply VSS
+//  1-VDD  		-->  	MS430EVM or supply 3V3. Consider controlling it with an I/O pin
+
+#include <msp430.h>
+#include <math.h>
+#include <stdlib.h>
+#include "nok5110LCD.h"
+#include "usciSpi.h"
+#include "timerB0.h"
+#include "profStats.h"
+#include "usciUart.h"
+#include <stdio.h>
+
+// 2-D array that stores the current pixelated state of the display in LOGICAL orientation.
+// remember a byte (8 bits) sets 8 vertical pixels in a column allowing 8x6=48 rows.
+// landscape uses [84][6], portrait (90/270 rotation) uses [48][11]. the rotation is applied by nokLcdFlush
+// note that this array is GLOBAL to this file only. In that way it is protected from access from other functions in files.
+// said another way - it is a private global array with local scope to the file in which the defining declaration exists.
+// we don't want other functions messing with the shadow RAM. This is the reason for static and for its dec/defn in this .c file
+// static here means that it does not have inter-file scope, it is local to this file only. This is a best practice when you want to
+// protect data structures from unwanted access by other functions in other files.
+static unsigned char currentPixelDisplay[LCD_MAX_COL][LCD_FB_BANKS];
+
+// logical size for the current rotation
+static unsigned char lcdWidth = LCD_MAX_COL;
+static unsigned char lcdHeight = LCD_MAX_ROW;
+static unsigned char lcdBanks = LCD_MAX_BANK;
+
+// logical -> physical transform. swap: logical rows run along physical x (90/270).
+// flipX: physical x is reversed. flipY: physical y is reversed (byte bits reversed)
+static unsigned char lcdSwap = 0;
+static unsigned char lcdFlipX = 0;
+static unsigned char lcdFlipY = 0;
+
+// last 8x8 block transposed by nokLcdPhysByte. 0xFF - none
+static unsigned char blkBank = 0xFF;
+static unsigned char blkCol = 0xFF;
+static unsigned char blkBytes[LCD_ROW_IN_BANK];
+
+// bit reversal of a byte. flips a bank byte top to bottom
+static const unsigned char nokBitRev[256] = {
+    0x00, 0x80, 0x40, 0xC0, 0x20, 0xA0, 0x60, 0xE0, 0x10, 0x90, 0x50, 0xD0, 0x30, 0xB0, 0x70, 0xF0,
+    0x08, 0x88, 0x48, 0xC8, 0x28, 0xA8, 0x68, 0xE8, 0x18, 0x98, 0x58, 0xD8, 0x38, 0xB8, 0x78, 0xF8,
+    0x04, 0x84, 0x44, 0xC4, 0x24, 0xA4, 0x64, 0xE4, 0x14, 0x94, 0x54, 0xD4, 0x34, 0xB4, 0x74, 0xF4,
+    0x0C, 0x8C, 0x4C, 0xCC, 0x2C, 0xAC, 0x6C, 0xEC, 0x1C, 0x9C, 0x5C, 0xDC, 0x3C, 0xBC, 0x7C, 0xFC,
+    0x02, 0x82, 0x42, 0xC2, 0x22, 0xA2, 0x62, 0xE2, 0x12, 0x92, 0x52, 0xD2, 0x32, 0xB2, 0x72, 0xF2,
+    0x0A, 0x8A, 0x4A, 0xCA, 0x2A, 0xAA, 0x6A, 0xEA, 0x1A, 0x9A, 0x5A, 0xDA, 0x3A, 0xBA, 0x7A, 0xFA,
+    0x06, 0x86, 0x46, 0xC6, 0x26, 0xA6, 0x66, 0xE6, 0x16, 0x96, 0x56, 0xD6, 0x36, 0xB6, 0x76, 0xF6,
+    0x0E, 0x8E, 0x4E, 0xCE, 0x2E, 0xAE, 0x6E, 0xEE, 0x1E, 0x9E, 0x5E, 0xDE, 0x3E, 0xBE, 0x7E, 0xFE,
+    0x01, 0x81, 0x41, 0xC1, 0x21, 0xA1, 0x61, 0xE1, 0x11, 0x91, 0x51, 0xD1, 0x31, 0xB1, 0x71, 0xF1,
+    0x09, 0x89, 0x49, 0xC9, 0x29, 0xA9, 0x69, 0xE9, 0x19, 0x99, 0x59, 0xD9, 0x39, 0xB9, 0x79, 0xF9,
+    0x05, 0x85, 0x45, 0xC5, 0x25, 0xA5, 0x65, 0xE5, 0x15, 0x95, 0x55, 0xD5, 0x35, 0xB5, 0x75, 0xF5,
+    0x0D, 0x8D, 0x4D, 0xCD, 0x2D, 0xAD, 0x6D, 0xED, 0x1D, 0x9D, 0x5D, 0xDD, 0x3D, 0xBD, 0x7D, 0xFD,
+    0x03, 0x83, 0x43, 0xC3, 0x23, 0xA3, 0x63, 0xE3, 0x13, 0x93, 0x53, 0xD3, 0x33, 0xB3, 0x73, 0xF3,
+    0x0B, 0x8B, 0x4B, 0xCB, 0x2B, 0xAB, 0x6B, 0xEB, 0x1B, 0x9B, 0x5B, 0xDB, 0x3B, 0xBB, 0x7B, 0xFB,
+    0x07, 0x87, 0x47, 0xC7, 0x27, 0xA7, 0x67, 0xE7, 0x17, 0x97, 0x57, 0xD7, 0x37, 0xB7, 0x77, 0xF7,
+    0x0F, 0x8F, 0x4F, 0xCF, 0x2F, 0xAF, 0x6F, 0xEF, 0x1F, 0x9F, 0x5F, 0xDF, 0x3F, 0xBF, 0x7F, 0xFF
+};
+
+// 1 - nokLcdFlush leaves the dirty ranges for a later flush (see nokLcdDeferFlush)
+static unsigned char flushDeferred = 0;
+
+// 1 - panel in power-down (nokLcdSleep). flushes wait for nokLcdResume
+static unsigned char lcdAsleep = 0;
+
+// configuration sent after reset and on every resume. the first function set also clears PD
+static const unsigned char nokLcdConfig[LCD_CONFIG_LEN] = {
+    LCD_EXT_INSTR, LCD_SET_OPVOLT, LCD_SET_TEMPCTRL, LCD_SET_SYSBIAS, LCD_BASIC_INSTR, LCD_NORMAL_DISP
+};
+
+// dirty PHYSICAL column range per bank. lo > hi means the bank matches the panel. sent by nokLcdFlush
+static unsigned char dirtyLo[LCD_MAX_BANK] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+static unsigned char dirtyHi[LCD_MAX_BANK];
+
+static unsigned long busBytes = 0;      // bytes put on the LCD bus
+static signed char burstDc;                  // D/C' level during a burst. -1 forces it to be driven
+
+// internal helpers, defined at the end of the file
+static void nokLcdBurstBegin(void);
+static void nokLcdBurstByte(unsigned char lcdByte, char cmdType);
+static void nokLcdBurstEnd(void);
+static void nokLcdConfigure(void);
+static void nokLcdPowerReset(void);
+static void nokLcdBlank(void);
+
+
+/************************************************************************************
+* Function: nokLcdInit
+* -
+* argument:
+*   none
+* return: none
+* Author: Greg Scutt
+* Date: Feb 20th, 2017
+* Modified: Oct 19th, 2026 - Marcus Kuhn. configuration and clear sent as bursts
+************************************************************************************/
+void nokLcdInit(void) {
+    // power-on RST sequence here.  The display is not powered until this sequence occurs.
+    nokLcdPowerReset();
+
+    P4OUT   &=  ~(SCE | DAT_CMD);   // Set DC and CE Low. This should be made a macro.  But is this command necassary? Doesn't nokLcdWrite do it?
+
+    // send initialization sequence to LCD module. one SCE' frame, shared with nokLcdResume
+    nokLcdConfigure();
+    lcdAsleep = 0;
+
+    nokLcdClear(); // clear the pixel memory and hence the display.
+    /* Sometimes necessary since the pixel ram is not defined after a PWR on and RST. The best practice would be to
+     always clear it so no residual pixels are set. You will sometimes see random pixels set and I think it is from not clearing the memory
+     which must be done manually. Try removing this function to see what happens.*/
+}
+
+/************************************************************************************
+* Function: nokLcdWrite
+* - performs write sequence to send data or command to nokLCD. Calls spiPutChar to transmit serially to nokLCD
+* argument:
+* Arguments: lcdByte - the 8 bit char (data or command) that is written to nokLCD.
+* 			 cmdType - 0 - lcdByte is a cmd,   1 - lcdByte is data.
+* return: none
+* Author: Greg Scutt
+* Date: Feb 20th, 2017
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokLcdWrite(char lcdByte, char cmdType) {
+	// check cmdType and output correct DAT_CMD signal to PORT4 based on it. Use definitions in .h file
+    switch(cmdType){
+        // -- if its a command, issue a 0
+        case DC_CMD:  P4OUT &= ~DAT_CMD;
+                      break;
+        // -- if its data, issue a 1
+        case DC_DAT:  P4OUT |= DAT_CMD;
+                      break;
+
+        default: break;
+    }
+
+    // clear RXIFG by reading RXBUF
+    UCB1RXBUF = 0;
+
+    // activate the SCE  chip select
+    P4OUT &= ~SCE;
+
+    SPI_TRACE(lcdByte, ((cmdType == DC_DAT) ? SPI_TRACE_DC : 0) | SPI_TRACE_CS_LOW | SPI_TRACE_CS_HIGH);
+
+    // transmit lcdByte with spiPutChar from Lab 3.  That function must stay in the spi C module.
+    usciB1SpiPutChar(lcdByte);
+
+    // wait for SPI transmission to complete. You need to poll an SPI interrupt flag. Which one RXIFG or TXIFG? Understand why.
+    while (!(UCB1IFG & UCRXIFG)); // When RXIFG == 1, RXBUF has received a complete character
+
+    // when transmission is complete deactivate the SCE */
+    P4OUT |= SCE;
+    busBytes++;
+}
+
+/************************************************************************************
+* Function: nokLcdSetPixel
+* -
+* argument:
+*	xPos - The horizontal pixel location in the domain (0 to nokLcdWidth()-1)
+*	yPos - The vertical pixel location in the domain (0 to nokLcdHeight()-1)
+*
+* return: 0 - pixel was valid and written.  1 - pixel not valid
+* Author: Greg Scutt
+* Date: Feb 20th, 2017
+* Modified: Oct 19th, 2026 - Marcus Kuhn. drawn through the shadow RAM and nokLcdFlush
+************************************************************************************/
+unsigned char  nokLcdSetPixel(unsigned char xPos, unsigned char yPos) {
+	unsigned char invalid;
+	PROF_START(t0);
+
+	invalid = nokLcdPlot(xPos, yPos);  // update the shadow RAM. the rotation is applied on the way out
+	if (!invalid)
+		nokLcdFlush();
+	PROF_STOP(PROF_SLOT_SETPIXEL, t0);
+	return invalid;
+}
+
+/************************************************************************************
+* Function: nokLcdDrawScrnLine
+* - draws either a horizontal or a vertical line on the Nokia display
+*
+* arguments: xCol coordinate
+*            yLine coordinate
+*
+* return: 0 if inputs were valid, -1 if not
+* Author: Marcus Kuhn
+* Date: Mar 11th, 2021
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokLcdDrawScrnLine(int xCol, int yRow, char mode){
+    int valid = 0;
+    PROF_START(t0);
+
+    // --  check if both coordinates are within boundaries
+    if(xCol < lcdWidth && yRow < lcdHeight){
+        if(mode == 'H'){                                    // a mode == 'H' is a horizontal line
+            while(xCol < lcdWidth)
+                nokLcdPlot(xCol++,yRow);            // auto-increment x after each call, until Max is reached
+        }
+        else if (mode == 'V')                               // likewise
+            while(yRow < lcdHeight)
+                nokLcdPlot(xCol,yRow++);            // auto-increment y after each call, until Max is reached
+        else valid = -1;
+        nokLcdFlush();                                      // whole line in one burst
+    }else valid = -1;                                       // if x, y or mode are illegal
+
+    PROF_STOP(PROF_SLOT_SCRNLINE, t0);
+    return valid;
+}
+
+/************************************************************************************
+* Function: nokLcdDrawLine
+* - draws a line between two coordinates in the Nokia display using Bresenham's line algorithm
+*
+* arguments: (x0, y0) start coordinate
+*            (x1, y1) finish coordinate
+*
+* return: 0 if inputs were valid, -1 if not
+* Author: Marcus Kuhn
+* Date: Mar 20th, 2021
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokLcdDrawLine(int x0, int y0, int x1, int y1){
+    volatile int valid = 0;
+    PROF_START(t0);
+
+    // check if any coordinate is outside display array range
+    if(x0 < lcdWidth && y0 < lcdHeight && x1 < lcdWidth && y1 < lcdHeight){
+        if (abs(y1 - y0) < abs(x1 - x0)){   // absolute change in x is greater than in y
+            if (x0 > x1)
+                plotLineLow(x1, y1, x0, y0);
+            else
+                plotLineLow(x0, y0, x1, y1);
+        }
+        else {
+            if (y0 > y1)
+                plotLineHigh(x1, y1, x0, y0);
+            else
+                plotLineHigh(x0, y0, x1, y1);
+        }
+        nokLcdFlush();                      // whole line in one burst
+    } else valid = -1;
+
+    PROF_STOP(PROF_SLOT_DRAWLINE, t0);
+    return valid;
+}
+
+/************************************************************************************
+* Function: nokLcdClear
+* - clears all pixels on LCD display. results in blank display.
+* argument:
+*   none
+* return: none
+* Author: Greg Scutt
+* Date: Feb 20th, 2017
+* Modified: Oct 19th, 2026 - Marcus Kuhn. one burst instead of a chip select per byte
+************************************************************************************/
+void nokLcdClear(void) {
+
+    unsigned char bank; // bank (group of 8 rows) on which pixel falls
+    unsigned char x;    // x coordinate to track columns
+    PROF_START(t0);
+
+    nokLcdBlank();
+
+    // a blank screen is blank in every orientation. clear the whole logical array
+    for (x = 0; x < LCD_MAX_COL; x++)
+        for (bank = 0; bank < LCD_FB_BANKS; bank++)
+            currentPixelDisplay[x][bank] = 0;       // update pixel display array to keep pixel state current
+    blkBank = 0xFF;
+    PROF_STOP(PROF_SLOT_CLEAR, t0);
+}
+
+//-- Bresenham's line algorithm for when dx > dy
+void plotLineLow(int x0, int y0, int x1, int y1){
+    volatile int dx = x1 - x0,
+                 dy = y1 - y0,
+                 yi = 1,
+                 y, x, D;
+
+    if (dy < 0){
+        yi = -1;
+        dy = -dy;
+    }
+
+    D = (2 * dy) - dx;
+    y = y0;
+
+    for (x = 0; x <= x1; x++){
+        nokLcdPlot(x, y);
+        if (D > 0){
+            y = y + yi;
+            D = D + (2 * (dy - dx));
+        }else
+            D = D + 2*dy;
+    }
+}
+
+//-- Bresenham's line algorithm for when dy > dx
+void plotLineHigh(int x0, int y0, int x1, int y1){
+    volatile int dx = x1 - x0,
+                 dy = y1 - y0,
+                 xi = 1,
+                 y, x, D;
+
+    if (dx < 0){
+        xi = -1;
+        dx = -dx;
+    }
+
+    D = (2 * dx) - dy;
+    x = x0;
+
+    for (y = y0; y <= y1; y++){
+        nokLcdPlot(x, y);
+        if (D > 0){
+            x = x + xi;
+            D = D + (2 * (dx - dy));
+        }else
+            D = D + 2*dx;
+    }
+}
+
+//-- extends the dirty range of a physical bank to include columns lo..hi
+static void nokLcdMarkPhys(unsigned char lo, unsigned char hi, unsigned char bank){
+    if (lo < dirtyLo[bank])
+        dirtyLo[bank] = lo;
+    if (dirtyLo[bank] > dirtyHi[bank] || hi > dirtyHi[bank])  // first bytes of the range, or past its end
+        dirtyHi[bank] = hi;
+}
+
+//-- marks the physical bytes showing logical byte (x, bank) dirty
+static void nokLcdMarkDirty(unsigned char x, unsigned char bank){
+    unsigned char lo, hi;
+
+    if (!lcdSwap){
+        if (lcdFlipX)
+            x = LCD_MAX_COL - 1 - x;
+        nokLcdMarkPhys(x, x, lcdFlipY ? LCD_MAX_BANK - 1 - bank : bank);
+    }
+    else {
+        // the 8 logical rows of the byte become up to 8 physical columns in one physical bank
+        lo = bank * LCD_ROW_IN_BANK;
+        hi = lo + LCD_ROW_IN_BANK - 1;
+        if (hi >= LCD_MAX_COL)
+            hi = LCD_MAX_COL - 1;
+        if (lo > hi)
+            return;
+        if (lcdFlipX){
+            bank = lo;                              // swap lo and hi through bank
+            lo = LCD_MAX_COL - 1 - hi;
+            hi = LCD_MAX_COL - 1 - bank;
+        }
+        bank = x / LCD_ROW_IN_BANK;
+        nokLcdMarkPhys(lo, hi, lcdFlipY ? LCD_MAX_BANK - 1 - bank : bank);
+    }
+    blkBank = 0xFF;                                 // cached transpose may hold the old byte
+}
+
+//-- 8x8 bit matrix transpose. out[j] bit k = in[k * stride] bit j.
+//-- shift/mask network (Hacker's Delight 7-3) on two 32 bit halves instead of 64 single bit moves
+static void nokLcdTranspose8(const unsigned char* in, unsigned int stride, unsigned char* out){
+    unsigned long x, y, t;
+
+    x = ((unsigned long)in[7 * stride] << 24) | ((unsigned long)in[6 * stride] << 16)
+      | ((unsigned int)in[5 * stride] << 8) | in[4 * stride];
+    y = ((unsigned long)in[3 * stride] << 24) | ((unsigned long)in[2 * stride] << 16)
+      | ((unsigned int)in[1 * stride] << 8) | in[0];
+
+    t = (x ^ (x >> 7)) & 0x00AA00AAUL;   x = x ^ t ^ (t << 7);
+    t = (y ^ (y >> 7)) & 0x00AA00AAUL;   y = y ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCCUL;  x = x ^ t ^ (t << 14);
+    t = (y ^ (y >> 14)) & 0x0000CCCCUL;  y = y ^ t ^ (t << 14);
+    t = (x & 0xF0F0F0F0UL) | ((y >> 4) & 0x0F0F0F0FUL);
+    y = ((x << 4) & 0xF0F0F0F0UL) | (y & 0x0F0F0F0FUL);
+    x = t;
+
+    out[7] = x >> 24; out[6] = x >> 16; out[5] = x >> 8; out[4] = x;
+    out[3] = y >> 24; out[2] = y >> 16; out[1] = y >> 8; out[0] = y;
+}
+
+//-- byte to send for physical column px of physical bank pb under the current rotation
+static unsigned char nokLcdPhysByte(unsigned char px, unsigned char pb){
+    unsigned char lx, lb, b;
+
+    if (lcdFlipY)
+        pb = LCD_MAX_BANK - 1 - pb;
+    if (lcdFlipX)
+        px = LCD_MAX_COL - 1 - px;
+
+    if (!lcdSwap){
+        b = currentPixelDisplay[px][pb];
+    }
+    else {
+        // physical bank pb shows logical columns 8pb..8pb+7, physical column px logical row px.
+        // transpose the 8x8 logical block once and serve its 8 columns from the cache
+        lb = px / LCD_ROW_IN_BANK;
+        lx = pb * LCD_ROW_IN_BANK;
+        if (lb != blkBank || lx != blkCol){
+            nokLcdTranspose8(&currentPixelDisplay[lx][lb], LCD_FB_BANKS, blkBytes);
+            blkBank = lb;
+            blkCol = lx;
+        }
+        b = blkBytes[px % LCD_ROW_IN_BANK];
+    }
+    return lcdFlipY ? nokBitRev[b] : b;
+}
+
+//-- starts a burst: SCE' low for every byte until nokLcdBurstEnd
+static void nokLcdBurstBegin(void){
+    burstDc = -1;
+    P4OUT &= ~SCE;
+}
+
+//-- queues one byte of a burst. TXBUF is reloaded as soon as it is free, RXIFG is not polled.
+//-- D/C' is sampled on the last SCLK of a byte so it only changes once the bus is idle.
+static void nokLcdBurstByte(unsigned char lcdByte, char cmdType){
+    if (cmdType != burstDc){
+        while (UCB1STAT & UCBUSY);
+        if (cmdType == DC_DAT)
+            P4OUT |= DAT_CMD;
+        else
+            P4OUT &= ~DAT_CMD;
+        SPI_TRACE(lcdByte, ((cmdType == DC_DAT) ? SPI_TRACE_DC : 0) | ((burstDc == -1) ? SPI_TRACE_CS_LOW : 0));
+        burstDc = cmdType;
+    }
+    else
+        SPI_TRACE(lcdByte, (cmdType == DC_DAT) ? SPI_TRACE_DC : 0);
+    usciB1SpiPutChar(lcdByte);
+    busBytes++;
+}
+
+//-- ends a burst once the last byte has left the shift register
+static void nokLcdBurstEnd(void){
+    while (UCB1STAT & UCBUSY);
+    P4OUT |= SCE;
+    SPI_TRACE_CS_RELEASE();
+}
+
+//-- zeroes the panel RAM in one SCE' frame and marks every bank clean. the shadow RAM is untouched
+static void nokLcdBlank(void){
+    unsigned char bank, x;
+
+    // start in first column of the first bank (0, 0)
+    nokLcdBurstBegin();
+    nokLcdBurstByte(LCD_SET_XRAM | 0, DC_CMD);
+    nokLcdBurstByte(LCD_SET_YRAM | 0, DC_CMD);
+
+    // sweep banks (or group of 8 rows)
+    for (bank = 0; bank < LCD_MAX_BANK; bank++) {
+        // sweep columns. X address is auto-incremented by one since V = 0 and wraps into the next bank
+        for (x = 0; x < LCD_MAX_COL; x++) {
+            nokLcdBurstByte(0, DC_DAT);             // clear all 8 pixels at (x,bank)
+        }
+        dirtyLo[bank] = 0xFF;                       // panel and shadow RAM agree once the shadow is cleared too
+        dirtyHi[bank] = 0;
+    }
+    nokLcdBurstEnd();
+}
+
+//-- sends the configuration sequence in one burst
+static void nokLcdConfigure(void){
+    unsigned char i;
+
+    nokLcdBurstBegin();
+    for (i = 0; i < LCD_CONFIG_LEN; i++)
+        nokLcdBurstByte(nokLcdConfig[i], DC_CMD);
+    nokLcdBurstEnd();
+}
+
+//-- power cycles VCC through P2.6 and strobes RST'. panel RAM is undefined afterwards
+static void nokLcdPowerReset(void){
+    // hold VCC low
+    P2OUT &= ~BIT6;
+    // hold !RES high
+    P2OUT |= BIT3;
+    // set PWR RST pins as outputs
+    P2DIR |= BIT3 + BIT6;
+    // PWR RST Sequence
+    _PWR;   // bring VCC high through P2.6 // #define _PWR P2OUT |= BIT6
+    _RST;   // send reset strobe through P2.3 // #define _RST P2OUT &= ~BIT3; P2OUT |= BIT3
+}
+
+//-- marks every physical byte dirty so the next flush rewrites the whole panel RAM
+static void nokLcdMarkAll(void){
+    unsigned char bank;
+
+    for (bank = 0; bank < LCD_MAX_BANK; bank++){
+        dirtyLo[bank] = 0;
+        dirtyHi[bank] = LCD_MAX_COL - 1;
+    }
+}
+
+/************************************************************************************
+* Function: nokLcdSetByte
+* - writes a whole bank byte (8 vertical pixels, LSB on top) into the shadow RAM only.
+*   the byte is marked dirty when it changes and goes out with the next nokLcdFlush.
+* arguments: xPos - column 0 to nokLcdWidth()-1
+*            bank - 0 to (nokLcdHeight()+7)/8 - 1, the logical banks of the current rotation
+*                   (6 at 0/180, 11 at 90/270 where the last holds rows 80 to 83)
+*            lcdByte - new pixel byte
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokLcdSetByte(unsigned char xPos, unsigned char bank, unsigned char lcdByte){
+    if (xPos < lcdWidth && bank < lcdBanks && currentPixelDisplay[xPos][bank] != lcdByte){
+        currentPixelDisplay[xPos][bank] = lcdByte;
+        nokLcdMarkDirty(xPos, bank);
+    }
+}
+
+/************************************************************************************
+* Function: nokLcdGetByte
+* - reads a bank byte from the shadow RAM
+* arguments: xPos - column 0 to nokLcdWidth()-1
+*            bank - 0 to (nokLcdHeight()+7)/8 - 1, the logical banks of the current rotation
+*                   (6 at 0/180, 11 at 90/270 where the last holds rows 80 to 83)
+* return: pixel byte, 0 if out of range
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned char nokLcdGetByte(unsigned char xPos, unsigned char bank){
+    if (xPos < lcdWidth && bank < lcdBanks)
+        return currentPixelDisplay[xPos][bank];
+    return 0;
+}
+
+/************************************************************************************
+* Function: nokLcdGetPixel
+* - reads one pixel from the shadow RAM, which is what the panel shows (or will after the
+*   next flush). the PCD8544 itself cannot be read back.
+* arguments: xPos - 0 to nokLcdWidth()-1
+*            yPos - 0 to nokLcdHeight()-1
+* return: 1 pixel set, 0 clear or out of range
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned char nokLcdGetPixel(unsigned char xPos, unsigned char yPos){
+    if (xPos >= lcdWidth || yPos >= lcdHeight)
+        return 0;
+    return (currentPixelDisplay[xPos][yPos / LCD_ROW_IN_BANK] >> (yPos % LCD_ROW_IN_BANK)) & 1;
+}
+
+/************************************************************************************
+* Function: nokLcdScrollUp
+* - moves the shadow RAM up by one bank (8 rows) and blanks the bottom bank.
+*   only bytes whose value changed are marked dirty. call nokLcdFlush to show it.
+* arguments: none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokLcdScrollUp(void){
+    unsigned char x, bank;
+
+    // a column is LCD_MAX_BANK consecutive bytes, so the move is a short block copy per column
+    for (x = 0; x < lcdWidth; x++){
+        for (bank = 0; bank < lcdBanks - 1; bank++)
+            nokLcdSetByte(x, bank, currentPixelDisplay[x][bank + 1]);
+        nokLcdSetByte(x, lcdBanks - 1, 0);
+    }
+}
+
+/************************************************************************************
+* Function: nokLcdFlush
+* - sends every dirty byte to the LCD in a single SCE' frame. spans that continue where
+*   the controller's auto-incremented address already points skip the address commands.
+*   does nothing while nokLcdDeferFlush(1) is in effect.
+* arguments: none
+* return: number of bytes (commands + data) put on the bus
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned int nokLcdFlush(void){
+    unsigned long start = busBytes;
+    unsigned int addr = 0xFFFF;         // controller RAM address (bank * 84 + x) after the last data byte. unknown at first
+    unsigned int spanAddr;
+    unsigned char bank, x;
+    PROF_START(t0);
+
+    if (flushDeferred || lcdAsleep)
+        return 0;
+
+    for (bank = 0; bank < LCD_MAX_BANK; bank++){
+        if (dirtyLo[bank] > dirtyHi[bank])
+            continue;
+        if (addr == 0xFFFF)
+            nokLcdBurstBegin();
+
+        spanAddr = bank * LCD_MAX_COL + dirtyLo[bank];
+        if (addr != 0xFFFF && spanAddr >= addr && spanAddr - addr <= 2){
+            // re-sending up to 2 clean bytes is no dearer than the X and Y address commands
+            for (; addr < spanAddr; addr++)
+                nokLcdBurstByte(nokLcdPhysByte(addr % LCD_MAX_COL, addr / LCD_MAX_COL), DC_DAT);
+        }
+        else if (spanAddr != addr){
+            nokLcdBurstByte(LCD_SET_XRAM | dirtyLo[bank], DC_CMD);
+            nokLcdBurstByte(LCD_SET_YRAM | bank, DC_CMD);
+        }
+
+        // X auto-increments and wraps into the next bank (V = 0), so one run covers the span
+        for (x = dirtyLo[bank]; x <= dirtyHi[bank]; x++)
+            nokLcdBurstByte(nokLcdPhysByte(x, bank), DC_DAT);
+
+        addr = bank * LCD_MAX_COL + dirtyHi[bank] + 1;
+        dirtyLo[bank] = 0xFF;
+        dirtyHi[bank] = 0;
+    }
+    if (addr != 0xFFFF)
+        nokLcdBurstEnd();
+
+    PROF_STOP(PROF_SLOT_FLUSH, t0);
+    return (unsigned int)(busBytes - start);
+}
+
+/************************************************************************************
+* Function: nokLcdBusBytes
+* - running count of bytes sent to the LCD (commands and data) since power up
+* arguments: none
+* return: byte count
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned long nokLcdBusBytes(void){
+    return busBytes;
+}
+
+/************************************************************************************
+* Function: nokLcdPlot
+* - sets a pixel in the shadow RAM only. nokLcdFlush sends it.
+* arguments: xPos - 0 to nokLcdWidth()-1
+*            yPos - 0 to nokLcdHeight()-1
+* return: 0 - pixel was valid.  1 - pixel not valid
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned char nokLcdPlot(unsigned char xPos, unsigned char yPos){
+    unsigned char bank = yPos / LCD_ROW_IN_BANK;     // shift, LCD_ROW_IN_BANK is a power of 2
+
+    if (xPos >= lcdWidth || yPos >= lcdHeight)
+        return 1;
+    nokLcdSetByte(xPos, bank, currentPixelDisplay[xPos][bank] | (BIT0 << (yPos % LCD_ROW_IN_BANK)));
+    return 0;
+}
+
+/************************************************************************************
+* Function: nokLcdSetRotation
+* - sets how the logical drawing coordinates map onto the panel and clears the screen.
+*   90 and 270 give a 48 x 84 portrait screen. the mirror flips the logical x axis before
+*   the rotation. drawing code is unaffected, the transform is applied by nokLcdFlush.
+* arguments: degrees - 0, 90, 180 or 270 (clockwise)
+*            mirror  - 1 mirror left/right, 0 not
+* return: 0 if valid, -1 if not
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokLcdSetRotation(int degrees, char mirror){
+    switch (degrees){
+    case 0:     lcdSwap = 0; lcdFlipX = 0; lcdFlipY = 0; break;
+    case 90:    lcdSwap = 1; lcdFlipX = 1; lcdFlipY = 0; break;     // x = 83 - ly, y = lx
+    case 180:   lcdSwap = 0; lcdFlipX = 1; lcdFlipY = 1; break;
+    case 270:   lcdSwap = 1; lcdFlipX = 0; lcdFlipY = 1; break;     // x = ly, y = 47 - lx
+    default:    return -1;
+    }
+    if (mirror){                                    // flip whichever physical axis logical x runs along
+        if (lcdSwap)
+            lcdFlipY ^= 1;
+        else
+            lcdFlipX ^= 1;
+    }
+
+    lcdWidth = lcdSwap ? LCD_MAX_ROW : LCD_MAX_COL;
+    lcdHeight = lcdSwap ? LCD_MAX_COL : LCD_MAX_ROW;
+    lcdBanks = (lcdHeight + LCD_ROW_IN_BANK - 1) / LCD_ROW_IN_BANK;
+
+    nokLcdClear();
+    return 0;
+}
+
+/************************************************************************************
+* Function: nokLcdWidth
+* - logical screen width for the current rotation
+* arguments: none
+* return: 84 or 48
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned char nokLcdWidth(void){
+    return lcdWidth;
+}
+
+/************************************************************************************
+* Function: nokLcdHeight
+* - logical screen height for the current rotation
+* arguments: none
+* return: 48 or 84
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned char nokLcdHeight(void){
+    return lcdHeight;
+}
+
+/************************************************************************************
+* Function: nokLcdDeferFlush
+* - while deferred, nokLcdFlush sends nothing and dirty bytes keep accumulating, so the
+*   drawing of several commands goes out in one burst once the deferral is lifted.
+*   nokLcdClear and nokLcdInit still write the panel directly.
+* arguments: defer - 1 defer flushes, 0 flush normally. nokLcdFlush is not called for you
+* return: previous setting, for restoring it
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned char nokLcdDeferFlush(unsigned char defer){
+    unsigned char prev = flushDeferred;
+
+    flushDeferred = defer;
+    return prev;
+}
+
+/************************************************************************************
+* Function: nokLcdSleep
+* - puts the PCD8544 in power-down (PD bit of the function set). pending drawing is flushed
+*   first. drawing while asleep only updates the shadow RAM, nokLcdResume sends it.
+* arguments: keepRam - 1 the panel RAM is left as is (it is retained while VCC stays on).
+*                      0 it is zeroed first, the datasheet's lowest power-down current. the
+*                      whole image is then sent again by nokLcdResume
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokLcdSleep(unsigned char keepRam){
+    unsigned char defer;
+
+    if (lcdAsleep)
+        return;
+
+    defer = nokLcdDeferFlush(0);
+    nokLcdFlush();                          // panel RAM matches the shadow RAM
+    nokLcdDeferFlush(defer);
+
+    if (!keepRam){
+        nokLcdBlank();
+        nokLcdMarkAll();                    // the panel is blank now. nokLcdResume sends the whole image
+    }
+    nokLcdBurstBegin();
+    nokLcdBurstByte(LCD_POWER_DOWN, DC_CMD);
+    nokLcdBurstEnd();
+    lcdAsleep = 1;
+}
+
+/************************************************************************************
+* Function: nokLcdResume
+* - warm start. no power cycle or reset: the configuration sequence is re-sent in one burst
+*   (its first function set clears PD), then the panel RAM is brought up to date from the
+*   shadow RAM in a second burst. only bytes drawn while asleep if the RAM was retained,
+*   all 504 if not.
+* arguments: retained - 1 VCC stayed on, 0 the panel lost power (a power cycle that did not
+*            reset the MCU). nokLcdSleep(0) needs no 0 here, it already marked the image
+* return: LCD bus bytes sent
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned int nokLcdResume(unsigned char retained){
+    unsigned long start = busBytes;
+    unsigned char defer;
+
+    nokLcdConfigure();
+    lcdAsleep = 0;
+    if (!retained)
+        nokLcdMarkAll();
+
+    defer = nokLcdDeferFlush(0);            // the panel must be correct when this returns
+    nokLcdFlush();
+    nokLcdDeferFlush(defer);
+    return (unsigned int)(busBytes - start);
+}
+
+/************************************************************************************
+* Function: nokLcdStartBench
+* - times the first correct frame after a cold start (what nokLcdInit sends, then the image
+*   again), a warm start with the RAM retained and a warm start after nokLcdSleep(0), on the
+*   current image. reports microseconds and bus bytes for each over UART A1
+* arguments: none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokLcdStartBench(void){
+    char line[64];
+    unsigned long t0, bytes0;
+    unsigned int bytes;
+    unsigned char defer;
+
+    // cold: what nokLcdInit does (power cycle, reset, configuration, clear), then the image
+    // redrawn. only the shadow RAM is kept, so the image survives to be sent again
+    bytes0 = busBytes;
+    t0 = timerB0Now();
+    nokLcdPowerReset();
+    nokLcdConfigure();
+    lcdAsleep = 0;
+    nokLcdBlank();
+    nokLcdMarkAll();
+    defer = nokLcdDeferFlush(0);
+    nokLcdFlush();
+    nokLcdDeferFlush(defer);
+    t0 = timerB0Now() - t0;
+    sprintf(line, "cold %lu us %lu bytes\r\n", timerB0TicksToUs(t0), busBytes - bytes0);
+    usciA1UartTxString(line);
+
+    nokLcdSleep(1);
+    t0 = timerB0Now();
+    bytes = nokLcdResume(1);
+    t0 = timerB0Now() - t0;
+    sprintf(line, "warm, RAM kept %lu us %u bytes\r\n", timerB0TicksToUs(t0), bytes);
+    usciA1UartTxString(line);
+
+    nokLcdSleep(0);
+    t0 = timerB0Now();
+    bytes = nokLcdResume(1);
+    t0 = timerB0Now() - t0;
+    sprintf(line, "warm, RAM zeroed %lu us %u bytes\r\n", timerB0TicksToUs(t0), bytes);
+    usciA1UartTxString(line);
+}
@@ -1,141 +1,328 @@
-/*************************************************************************************************
- * nok5110LCD.h
- * - C interface file for NOKIA 5110 LCD.
- *
- *  Author: Greg Scutt
- *  Created on: Feb 20th, 2017
- **************************************************************************************************/
-
-// nok5110LCD pin connectivity --> to MSP-EXP430F5529LP EVM.
-// Assumes UCB1SI  is used.
-//  8-GND  		-->  	MS430 Ground
-//  7-LIGHT     -->     P8.1
-//  6-VCC  		-->  	MSP430EVM P2.6
-//  5-SCLK      -->     MSP430EVM  P4.3 or UCB1CLK
-//  4-DN(MOSI)  -->     MSP430EVM  P4.1 or UCB1SIMO
-//  3-D/C'      -->     MSP430EVM  P4.2 Kept as I/O pin !!
-//  2-SCE'      -->     MSP430EVM  P4.0 chip select     Kept as I/O pin !!
-//  1-RST'      -->     MSP430EVM or supply VSS.  Can tie to I/O pin if user wants. data sheet says RESET is necessary .. but?
-
-
-#ifndef nok5110LCD_H_
-#define nok5110LCD_H_
-
-// nok5110 pin --> msp430 PORT4 bit position
-#define SCLK  	BIT3
-#define DAT_CMD BIT2
-#define SIMO 	BIT1
-#define	SCE   	BIT0
-
-// constants for cmdType argument passed to the nokLcdWrite function
-#define DC_CMD  0	// command control
-#define DC_DAT  1	// data control
-
-// NOKIA 5110 LCD row,col MAX
-#define LCD_MAX_COL 84  	// 	max # of columns.  84 pixels in x direction
-#define LCD_MAX_ROW 48     	// 	max # of row.  48 pixels in y direction
-
-// NOKIA 5110 LCD controller instructions for initialization
-#define LCD_NORMAL_DISP      	0x0C // normal display control
-#define LCD_EXT_INSTR 			0x21 // enable extended instruction set
-#define LCD_BASIC_INSTR      	0x20 // enable basic instruction set
-#define LCD_SET_SYSBIAS       	0x13 // set system bias mode
-#define LCD_SET_OPVOLT     		0xBC // set operation voltage for contrast ctrl
-#define LCD_SET_TEMPCTRL       	0x04 // set coeff 2
-#define LCD_SET_YRAM          	0x40 // set Y address of RAM
-#define LCD_SET_XRAM          	0x80 // set X address of RAM
-
-
-#define LCD_ROW_IN_BANK 8 	    // 8 rows in a bank. 6 banks, so  8x6 = 48 rows of pixels. y coordinate
-
-//-- added by me
-#define _PWR P2OUT |= BIT6                // power on transistor
-#define _RST P2OUT &= ~BIT3; P2OUT |= BIT3 // reset strobe
-
-/************************************************************************************
-* Function: nokLcdInit
-* -
-* argument:
-*	none
-* return: none
-* Author: Greg Scutt
-* Date: Feb 20th, 2017
-* Modified: <date of any mods> usually taken care of by rev control
-************************************************************************************/
-void nokLcdInit(void);
-
-/************************************************************************************
-* Function: nokLcdSetPixel
-* -
-* argument:
-*	xPos - The horizontal pixel location in the domain (0 to 83)
-*	yPos - The vertical pixel location in the domain (0 to 47)
-*
-* return: 0 - pixel was valid and written.  1 - pixel not valid
-* Author: Greg Scutt
-* Date: Feb 20th, 2017
-* Modified: <date of any mods> usually taken care of by rev control
-************************************************************************************/
-unsigned char nokLcdSetPixel(unsigned char xPos, unsigned char yPos);
-
-/************************************************************************************
-* Function: nokLcdWrite
-* - performs write sequence to send data or command to nokLCD. Calls spiTxByte transmit serially to nokLCD
-* argument:
-* Arguments: lcdByte - the 8 bit char (data or command) that is written to nokLCD.
-* 			 cmdType - 0 - lcdByte is a cmd,   1 - lcdByte is data.
-* return: none
-* Author: Greg Scutt
-* Date: Feb 20th, 2017
-* Modified: <date of any mods> usually taken care of by rev control
-************************************************************************************/
-void nokLcdWrite(char lcdByte, char cmdType);
-
-/************************************************************************************
-* Function: nokLcdDrawScrnLine
-* - draws either a horizontal or a vertical line on the Nokia display
-*
-* arguments: x coordinate
-*            y coordinate
-*            mode - Vertical or Horizontal line
-*
-* return: 0 if inputs were valid, -1 if not
-* Author: Marcus Kuhn
-* Date: Mar 11th, 2021
-* Modified: <date of any mods> usually taken care of by rev control
-************************************************************************************/
-int nokLcdDrawScrnLine(int x, int y, char mode);
-
-/************************************************************************************
-* Function: nokLcdDrawLine
-* - draws a line between two coordinates in the Nokia display using bresenham's line algorithm
-*
-* arguments: (x0, y0) start coordinate
-*            (x1, y1) finish coordinate
-*
-* return: 0 if inputs were valid, -1 if not
-* Author: Marcus Kuhn
-* Date: Mar 20th, 2021
-* Modified: <date of any mods> usually taken care of by rev control
-************************************************************************************/
-int nokLcdDrawLine(int x0, int y0, int x1, int y1);
-
-//-- Bresenham's line algorithm for when dx > dy
-void plotLineLow(int x0, int y0, int x1, int y1);
-
-//-- Bresenham's line algorithm for when dy > dx
-void plotLineHigh(int x0, int y0, int x1, int y1);
-
-/************************************************************************************
-* Function: nokLcdClear
-* - clears all pixels on LCD diplay. results in blank display.
-* argument:
-*   none
-* return: none
-* Author: Greg Scutt
-* Date: Feb 20th, 2017
-* Modified: <date of any mods> usually taken care of by rev control
-************************************************************************************/
-void nokLcdClear(void);
-
-#endif /* nok5110LCD_H_ */
+/*************************************************************************************************
+ * nok5110LCD.h
+ * - C interface file for NOKIA 5110 LCD.
+ *
+ *  Author: Greg Scutt
+ *  Created on: Feb 20th, 2017
+ **************************************************************************************************/
+
+// nok5110LCD pin connectivity --> to MSP-EXP430F5529LP EVM.
+// Assumes UCB1SI  is used.
+//  8-GND  		-->  	MS430 Ground
+//  7-LIGHT     -->     P8.1
+//  6-VCC  		-->  	MSP430EVM P2.6
+//  5-SCLK      -->     MSP430EVM  P4.3 or UCB1CLK
+//  4-DN(MOSI)  -->     MSP430EVM  P4.1 or UCB1SIMO
+//  3-D/C'      -->     MSP430EVM  P4.2 Kept as I/O pin !!
+//  2-SCE'      -->     MSP430EVM  P4.0 chip select     Kept as I/O pin !!
+//  1-RST'      -->     MSP430EVM or supply VSS.  Can tie to I/O pin if user wants. data sheet says RESET is necessary .. but?
+
+
+#ifndef nok5110LCD_H_
+#define nok5110LCD_H_
+
+// nok5110 pin --> msp430 PORT4 bit position
+#define SCLK  	BIT3
+#define DAT_CMD BIT2
+#define SIMO 	BIT1
+#define	SCE   	BIT0
+
+// constants for cmdType argument passed to the nokLcdWrite function
+#define DC_CMD  0	// command control
+#define DC_DAT  1	// data control
+
+// PCD8544 maximum serial clock
+#define LCD_SCLK_MAX_HZ 4000000UL
+
+// NOKIA 5110 LCD row,col MAX
+#define LCD_MAX_COL 84  	// 	max # of columns.  84 pixels in x direction
+#define LCD_MAX_ROW 48     	// 	max # of row.  48 pixels in y direction
+
+// NOKIA 5110 LCD controller instructions for initialization
+#define LCD_NORMAL_DISP      	0x0C // normal display control
+#define LCD_EXT_INSTR 			0x21 // enable extended instruction set
+#define LCD_BASIC_INSTR      	0x20 // enable basic instruction set
+#define LCD_SET_SYSBIAS       	0x13 // set system bias mode
+#define LCD_SET_OPVOLT     		0xBC // set operation voltage for contrast ctrl
+#define LCD_SET_TEMPCTRL       	0x04 // set coeff 2
+#define LCD_SET_YRAM          	0x40 // set Y address of RAM
+#define LCD_SET_XRAM          	0x80 // set X address of RAM
+#define LCD_PD_BIT              0x04 // function set PD. chip powered down, RAM kept while VCC is on
+#define LCD_POWER_DOWN          (LCD_BASIC_INSTR | LCD_PD_BIT)
+#define LCD_CONFIG_LEN          6    // commands in the configuration sequence (see nokLcdInit)
+
+
+#define LCD_ROW_IN_BANK 8 	    // 8 rows in a bank. 6 banks, so  8x6 = 48 rows of pixels. y coordinate
+#define LCD_MAX_BANK (LCD_MAX_ROW / LCD_ROW_IN_BANK)   // 6 banks
+#define LCD_FB_BANKS ((LCD_MAX_COL + LCD_ROW_IN_BANK - 1) / LCD_ROW_IN_BANK)  // 11 banks. 84 rows in portrait
+
+//-- added by me
+#define _PWR P2OUT |= BIT6                // power on transistor
+#define _RST P2OUT &= ~BIT3; P2OUT |= BIT3 // reset strobe
+
+/************************************************************************************
+* Function: nokLcdInit
+* -
+* argument:
+*	none
+* return: none
+* Author: Greg Scutt
+* Date: Feb 20th, 2017
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokLcdInit(void);
+
+/************************************************************************************
+* Function: nokLcdSetPixel
+* -
+* argument:
+*	xPos - The horizontal pixel location in the domain (0 to 83)
+*	yPos - The vertical pixel location in the domain (0 to 47)
+*
+* return: 0 - pixel was valid and written.  1 - pixel not valid
+* Author: Greg Scutt
+* Date: Feb 20th, 2017
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned char nokLcdSetPixel(unsigned char xPos, unsigned char yPos);
+
+/************************************************************************************
+* Function: nokLcdWrite
+* - performs write sequence to send data or command to nokLCD. Calls spiTxByte transmit serially to nokLCD
+* argument:
+* Arguments: lcdByte - the 8 bit char (data or command) that is written to nokLCD.
+* 			 cmdType - 0 - lcdByte is a cmd,   1 - lcdByte is data.
+* return: none
+* Author: Greg Scutt
+* Date: Feb 20th, 2017
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokLcdWrite(char lcdByte, char cmdType);
+
+/************************************************************************************
+* Function: nokLcdDrawScrnLine
+* - draws either a horizontal or a vertical line on the Nokia display
+*
+* arguments: x coordinate
+*            y coordinate
+*            mode - Vertical or Horizontal line
+*
+* return: 0 if inputs were valid, -1 if not
+* Author: Marcus Kuhn
+* Date: Mar 11th, 2021
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokLcdDrawScrnLine(int x, int y, char mode);
+
+/************************************************************************************
+* Function: nokLcdDrawLine
+* - draws a line between two coordinates in the Nokia display using bresenham's line algorithm
+*
+* arguments: (x0, y0) start coordinate
+*            (x1, y1) finish coordinate
+*
+* return: 0 if inputs were valid, -1 if not
+* Author: Marcus Kuhn
+* Date: Mar 20th, 2021
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokLcdDrawLine(int x0, int y0, int x1, int y1);
+
+//-- Bresenham's line algorithm for when dx > dy
+void plotLineLow(int x0, int y0, int x1, int y1);
+
+//-- Bresenham's line algorithm for when dy > dx
+void plotLineHigh(int x0, int y0, int x1, int y1);
+
+/************************************************************************************
+* Function: nokLcdClear
+* - clears all pixels on LCD diplay. results in blank display.
+* argument:
+*   none
+* return: none
+* Author: Greg Scutt
+* Date: Feb 20th, 2017
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokLcdClear(void);
+
+/************************************************************************************
+* Function: nokLcdSetByte
+* - writes a whole bank byte (8 vertical pixels, LSB on top) into the shadow RAM only.
+*   the byte is marked dirty when it changes and goes out with the next nokLcdFlush.
+* arguments: xPos - column 0 to nokLcdWidth()-1
+*            bank - 0 to (nokLcdHeight()+7)/8 - 1, the logical banks of the current rotation
+*                   (6 at 0/180, 11 at 90/270 where the last holds rows 80 to 83)
+*            lcdByte - new pixel byte
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokLcdSetByte(unsigned char xPos, unsigned char bank, unsigned char lcdByte);
+
+/************************************************************************************
+* Function: nokLcdGetByte
+* - reads a bank byte from the shadow RAM
+* arguments: xPos - column 0 to nokLcdWidth()-1
+*            bank - 0 to (nokLcdHeight()+7)/8 - 1, the logical banks of the current rotation
+*                   (6 at 0/180, 11 at 90/270 where the last holds rows 80 to 83)
+* return: pixel byte, 0 if out of range
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned char nokLcdGetByte(unsigned char xPos, unsigned char bank);
+
+/************************************************************************************
+* Function: nokLcdGetPixel
+* - reads one pixel from the shadow RAM, which is what the panel shows (or will after the
+*   next flush). the PCD8544 itself cannot be read back.
+* arguments: xPos - 0 to nokLcdWidth()-1
+*            yPos - 0 to nokLcdHeight()-1
+* return: 1 pixel set, 0 clear or out of range
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned char nokLcdGetPixel(unsigned char xPos, unsigned char yPos);
+
+/************************************************************************************
+* Function: nokLcdScrollUp
+* - moves the shadow RAM up by one bank (8 rows) and blanks the bottom bank.
+*   only bytes whose value changed are marked dirty. call nokLcdFlush to show it.
+* arguments: none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokLcdScrollUp(void);
+
+/************************************************************************************
+* Function: nokLcdFlush
+* - sends every dirty byte to the LCD in a single SCE' frame. spans that continue where
+*   the controller's auto-incremented address already points skip the address commands.
+*   does nothing while nokLcdDeferFlush(1) is in effect.
+* arguments: none
+* return: number of bytes (commands + data) put on the bus
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned int nokLcdFlush(void);
+
+/************************************************************************************
+* Function: nokLcdBusBytes
+* - running count of bytes sent to the LCD (commands and data) since power up
+* arguments: none
+* return: byte count
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned long nokLcdBusBytes(void);
+
+/************************************************************************************
+* Function: nokLcdPlot
+* - sets a pixel in the shadow RAM only. nokLcdFlush sends it.
+* arguments: xPos - 0 to nokLcdWidth()-1
+*            yPos - 0 to nokLcdHeight()-1
+* return: 0 - pixel was valid.  1 - pixel not valid
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned char nokLcdPlot(unsigned char xPos, unsigned char yPos);
+
+/************************************************************************************
+* Function: nokLcdSetRotation
+* - sets how the logical drawing coordinates map onto the panel and clears the screen.
+*   90 and 270 give a 48 x 84 portrait screen. applied by nokLcdFlush.
+* arguments: degrees - 0, 90, 180 or 270 (clockwise)
+*            mirror  - 1 mirror left/right, 0 not
+* return: 0 if valid, -1 if not
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokLcdSetRotation(int degrees, char mirror);
+
+/************************************************************************************
+* Function: nokLcdWidth
+* - logical screen width for the current rotation
+* arguments: none
+* return: 84 or 48
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned char nokLcdWidth(void);
+
+/************************************************************************************
+* Function: nokLcdHeight
+* - logical screen height for the current rotation
+* arguments: none
+* return: 48 or 84
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned char nokLcdHeight(void);
+
+/************************************************************************************
+* Function: nokLcdDeferFlush
+* - while deferred, nokLcdFlush sends nothing and dirty bytes keep accumulating, so the
+*   drawing of several commands goes out in one burst once the deferral is lifted.
+*   nokLcdClear and nokLcdInit still write the panel directly.
+* arguments: defer - 1 defer flushes, 0 flush normally. nokLcdFlush is not called for you
+* return: previous setting, for restoring it
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned char nokLcdDeferFlush(unsigned char defer);
+
+/************************************************************************************
+* Function: nokLcdSleep
+* - puts the PCD8544 in power-down (PD bit of the function set). pending drawing is flushed
+*   first. drawing while asleep only updates the shadow RAM, nokLcdResume sends it.
+* arguments: keepRam - 1 the panel RAM is left as is (it is retained while VCC stays on).
+*                      0 it is zeroed first, the datasheet's lowest power-down current. the
+*                      whole image is then sent again by nokLcdResume
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokLcdSleep(unsigned char keepRam);
+
+/************************************************************************************
+* Function: nokLcdResume
+* - warm start. no power cycle or reset: the configuration sequence is re-sent in one burst
+*   (its first function set clears PD), then the panel RAM is brought up to date from the
+*   shadow RAM in a second burst. only bytes drawn while asleep if the RAM was retained,
+*   all 504 if not.
+* arguments: retained - 1 VCC stayed on, 0 the panel lost power (a power cycle that did not
+*            reset the MCU). nokLcdSleep(0) needs no 0 here, it already marked the image
+* return: LCD bus bytes sent
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned int nokLcdResume(unsigned char retained);
+
+/************************************************************************************
+* Function: nokLcdStartBench
+* - times the first correct frame after a cold start (what nokLcdInit sends, then the image
+*   again), a warm start with the RAM retained and a warm start after nokLcdSleep(0), on the
+*   current image. reports microseconds and bus bytes for each over UART A1
+* arguments: none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokLcdStartBench(void);
+
+#endif /* nok5110LCD_H_ */
@@ -0,0 +1,168 @@
+/*************************************************************************************************
+ * nokConsole.c
+ * - C implementation or source file for the text console on the NOKIA 5110 LCD.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+#include <stdio.h>
+#include <stdarg.h>
+
+#include "nokConsole.h"
+#include "timerB0.h"
+#include "usciUart.h"
+
+static unsigned char conCol = 0;        // cursor column 0 .. CON_COLS. CON_COLS means wrap before the next char
+static unsigned char conRow = 0;        // cursor line (bank) 0 .. CON_ROWS-1
+static unsigned char conCols = 0;       // grid the cursor was placed on. the rotation can change it
+static unsigned char conRows = 0;
+
+//-- homes the cursor when the grid changed size since it was placed, so it never points off screen
+static void nokConsoleFit(void){
+    if (conCols != CON_COLS || conRows != CON_ROWS){
+        conCols = CON_COLS;
+        conRows = CON_ROWS;
+        conCol = 0;
+        conRow = 0;
+    }
+}
+
+//-- moves the cursor to the start of the next line, scrolling when it is on the last one
+static void nokConsoleNewLine(void){
+    conCol = 0;
+    if (conRow < CON_ROWS - 1)
+        conRow++;
+    else
+        nokLcdScrollUp();
+}
+
+/************************************************************************************
+* Function: nokConsoleClear
+* - blanks the screen and homes the cursor
+* argument:
+*   none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokConsoleClear(void){
+    unsigned char x, bank;
+
+    for (bank = 0; bank < LCD_FB_BANKS; bank++)
+        for (x = 0; x < nokLcdWidth(); x++)
+            nokLcdSetByte(x, bank, 0);          // banks past the current height are ignored
+    nokLcdFlush();
+    nokConsoleFit();
+    conCol = 0;
+    conRow = 0;
+}
+
+/************************************************************************************
+* Function: nokConsolePutc
+* - draws a character at the cursor into the shadow RAM and advances the cursor.
+*   '\n' starts a new line, '\r' returns to column 0. wraps at CON_COLS and scrolls at
+*   the bottom. nothing is sent until nokLcdFlush (nokConsolePuts/Printf flush for you).
+* argument:
+*   c - character
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokConsolePutc(char c){
+    const unsigned char* glyph;
+    unsigned char x, i;
+
+    nokConsoleFit();
+    if (c == '\n'){
+        nokConsoleNewLine();
+        return;
+    }
+    if (c == '\r'){
+        conCol = 0;
+        return;
+    }
+
+    if (conCol >= CON_COLS)             // wrap lazily so a full line does not leave an empty one behind
+        nokConsoleNewLine();
+
+    glyph = nokFontGlyph(c);
+    x = conCol * NOK_FONT_PITCH;
+    for (i = 0; i < NOK_FONT_W; i++)
+        nokLcdSetByte(x + i, conRow, glyph[i]);
+    nokLcdSetByte(x + NOK_FONT_W, conRow, 0);  // blank spacing column
+    conCol++;
+}
+
+/************************************************************************************
+* Function: nokConsolePuts
+* - writes a string at the cursor and flushes the changes to the LCD once
+* argument:
+*   str - NULL terminated string
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokConsolePuts(const char* str){
+    while (*str != NULL_CHAR)
+        nokConsolePutc(*str++);
+    nokLcdFlush();
+}
+
+/************************************************************************************
+* Function: nokConsolePrintf
+* - printf to the console. output longer than CON_PRINTF_SZ - 1 is truncated.
+*   ex: nokConsolePrintf("T=%d.%dC\n", t / 10, t % 10);
+* argument:
+*   fmt - printf format, followed by its arguments
+* return: number of characters written
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokConsolePrintf(const char* fmt, ...){
+    char buf[CON_PRINTF_SZ];
+    va_list args;
+    int n;
+
+    va_start(args, fmt);
+    n = vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+
+    nokConsolePuts(buf);
+    return (n < (int)sizeof(buf)) ? n : (int)sizeof(buf) - 1;
+}
+
+/************************************************************************************
+* Function: nokConsoleBench
+* - prints nLines numbered lines (scrolling once the screen is full) and reports the time,
+*   lines per second and LCD bus bytes over UART A1
+* argument:
+*   nLines - number of lines to print
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokConsoleBench(unsigned int nLines){
+    char line[64];
+    unsigned long bytes0 = nokLcdBusBytes();
+    unsigned long t0 = timerB0Now();
+    unsigned long us;
+    unsigned int i;
+    unsigned char defer = nokLcdDeferFlush(0);     // measure real flushes even when run by the scheduler
+
+    for (i = 0; i < nLines; i++)
+        nokConsolePrintf("line %u\n", i);
+
+    us = timerB0TicksToUs(timerB0Now() - t0);
+    sprintf(line, "%u lines %lu us %lu lines/s %lu bus bytes\r\n", nLines, us,
+            us ? (unsigned long)((unsigned long long)nLines * 1000000UL / us) : 0,
+            nokLcdBusBytes() - bytes0);
+    usciA1UartTxString(line);
+    nokLcdDeferFlush(defer);
+}
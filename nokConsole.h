@@ -0,0 +1,87 @@
+/*************************************************************************************************
+ * nokConsole.h
+ * - C interface file for the text console on the NOKIA 5110 LCD.
+ *   14 x 6 character grid (5x7 font on a 6 pixel pitch, one text line per bank) with a
+ *   cursor, line wrap and scroll. Scrolling moves the shadow RAM up one bank and
+ *   nokLcdFlush sends only the bytes that changed, in one burst.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#ifndef NOKCONSOLE_H_
+#define NOKCONSOLE_H_
+
+#include "nok5110LCD.h"
+#include "nokFont.h"
+
+#define CON_COLS        (nokLcdWidth() / NOK_FONT_PITCH)    // 14 characters per line, 8 in portrait
+#define CON_ROWS        (nokLcdHeight() / LCD_ROW_IN_BANK)  // 6 lines, 10 in portrait
+#define CON_PRINTF_SZ   64                              // longest formatted nokConsolePrintf output
+
+/************************************************************************************
+* Function: nokConsoleClear
+* - blanks the screen and homes the cursor
+* argument:
+*   none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokConsoleClear(void);
+
+/************************************************************************************
+* Function: nokConsolePutc
+* - draws a character at the cursor into the shadow RAM and advances the cursor.
+*   '\n' starts a new line, '\r' returns to column 0. wraps at CON_COLS and scrolls at
+*   the bottom. nothing is sent until nokLcdFlush (nokConsolePuts/Printf flush for you).
+*   the cursor goes home if the rotation changed the grid since the last character.
+* argument:
+*   c - character
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokConsolePutc(char c);
+
+/************************************************************************************
+* Function: nokConsolePuts
+* - writes a string at the cursor and flushes the changes to the LCD once
+* argument:
+*   str - NULL terminated string
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokConsolePuts(const char* str);
+
+/************************************************************************************
+* Function: nokConsolePrintf
+* - printf to the console. output longer than CON_PRINTF_SZ - 1 is truncated.
+*   ex: nokConsolePrintf("T=%d.%dC\n", t / 10, t % 10);
+* argument:
+*   fmt - printf format, followed by its arguments
+* return: number of characters written
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokConsolePrintf(const char* fmt, ...);
+
+/************************************************************************************
+* Function: nokConsoleBench
+* - prints nLines numbered lines (scrolling once the screen is full) and reports the time,
+*   lines per second and LCD bus bytes over UART A1
+* argument:
+*   nLines - number of lines to print
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokConsoleBench(unsigned int nLines);
+
+#endif /* NOKCONSOLE_H_ */
@@ -0,0 +1,291 @@
+/*************************************************************************************************
+ * nokFill.c
+ * - C implementation or source file for region fills on the NOKIA 5110 LCD shadow RAM.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+#include <string.h>
+
+#include "nokFill.h"
+
+// segment stack for nokLcdFill. column x - dx has a filled span lo..hi, column x is still to be explored
+static FILL_SEG fillStack[FILL_STACK_SZ];
+static unsigned char fillSp;
+static unsigned char fillOverflow;
+static unsigned char fillConn;
+
+// one bit per pixel this fill has set, bytes laid out [x * fillBanks + bank]. set pixels read the
+// same as the boundary in the shadow RAM, this tells them apart when the stack overflowed
+static unsigned char fillMap[FILL_MAP_SZ];
+static unsigned char fillBanks;
+
+// XOR applied to bank bytes so the region being filled always reads as 0
+static unsigned char fillInv;
+
+//-- bank byte with the region's pixels as 0
+static unsigned char nokFillByte(unsigned char x, unsigned char bank){
+    return nokLcdGetByte(x, bank) ^ fillInv;
+}
+
+//-- 1 if (x, y) is outside the region
+static unsigned char nokFillIsSet(unsigned char x, unsigned char y){
+    return (nokFillByte(x, y / LCD_ROW_IN_BANK) >> (y % LCD_ROW_IN_BANK)) & 1;
+}
+
+//-- bank byte mask for rows lo..hi, both inside bank
+static unsigned char nokFillMask(unsigned char lo, unsigned char hi){
+    return (unsigned char)((0xFF << (lo % LCD_ROW_IN_BANK)) & (0xFF >> (LCD_ROW_IN_BANK - 1 - hi % LCD_ROW_IN_BANK)));
+}
+
+//-- writes colour into rows lo..hi of column x. one byte per bank
+static void nokFillSpan(unsigned char x, unsigned char lo, unsigned char hi, unsigned char colour){
+    unsigned char bank, top, bot, mask;
+
+    for (bank = lo / LCD_ROW_IN_BANK; bank <= hi / LCD_ROW_IN_BANK; bank++){
+        top = bank * LCD_ROW_IN_BANK;
+        bot = top + LCD_ROW_IN_BANK - 1;
+        mask = nokFillMask(lo > top ? lo : top, hi < bot ? hi : bot);
+        if (colour)
+            nokLcdSetByte(x, bank, nokLcdGetByte(x, bank) | mask);
+        else
+            nokLcdSetByte(x, bank, nokLcdGetByte(x, bank) & ~mask);
+    }
+}
+
+//-- fills rows lo..hi of column x and records them in fillMap
+static void nokFillRun(unsigned char x, unsigned char lo, unsigned char hi, unsigned char colour){
+    unsigned char bank, top, bot;
+
+    nokFillSpan(x, lo, hi, colour);
+    for (bank = lo / LCD_ROW_IN_BANK; bank <= hi / LCD_ROW_IN_BANK; bank++){
+        top = bank * LCD_ROW_IN_BANK;
+        bot = top + LCD_ROW_IN_BANK - 1;
+        fillMap[x * fillBanks + bank] |= nokFillMask(lo > top ? lo : top, hi < bot ? hi : bot);
+    }
+}
+
+//-- 1 if this fill has set a pixel in column x that touches rows lo..hi of a neighbour column
+static unsigned char nokFillMapAny(unsigned char x, unsigned char lo, unsigned char hi){
+    unsigned char bank, top, bot;
+
+    if (fillConn == 8){
+        if (lo > 0)
+            lo--;
+        if (hi < nokLcdHeight() - 1)
+            hi++;
+    }
+    for (bank = lo / LCD_ROW_IN_BANK; bank <= hi / LCD_ROW_IN_BANK; bank++){
+        top = bank * LCD_ROW_IN_BANK;
+        bot = top + LCD_ROW_IN_BANK - 1;
+        if (fillMap[x * fillBanks + bank] & nokFillMask(lo > top ? lo : top, hi < bot ? hi : bot))
+            return 1;
+    }
+    return 0;
+}
+
+//-- first region row in column x from y to hi, or hi + 1 if none. set banks are stepped over in one read
+static unsigned char nokFillNext(unsigned char x, unsigned char y, unsigned char hi){
+    while (y <= hi){
+        if (y % LCD_ROW_IN_BANK == 0 && nokFillByte(x, y / LCD_ROW_IN_BANK) == 0xFF)
+            y += LCD_ROW_IN_BANK;
+        else if (nokFillIsSet(x, y))
+            y++;
+        else
+            return y;
+    }
+    return hi + 1;
+}
+
+//-- pushes a segment. off screen columns and columns with nothing to fill next to lo..hi are skipped,
+//-- which keeps most dead ends off the stack. a full stack drops it and flags a rescan (nokFillRescan)
+static void nokFillPush(int x, unsigned char lo, unsigned char hi, signed char dx){
+    unsigned char a = lo, b = hi;
+
+    if (x < 0 || x >= nokLcdWidth())
+        return;
+    if (fillConn == 8){
+        if (a > 0)
+            a--;
+        if (b < nokLcdHeight() - 1)
+            b++;
+    }
+    if (nokFillNext(x, a, b) > b)
+        return;
+    if (fillSp < FILL_STACK_SZ){
+        fillStack[fillSp].x = x;
+        fillStack[fillSp].lo = lo;
+        fillStack[fillSp].hi = hi;
+        fillStack[fillSp].dx = dx;
+        fillSp++;
+    }
+    else
+        fillOverflow = 1;
+}
+
+//-- grows a region run in column x from y up to its first row. clear banks are taken in one read
+static unsigned char nokFillTop(unsigned char x, unsigned char y){
+    while (y > 0 && !nokFillIsSet(x, y - 1)){
+        if (y % LCD_ROW_IN_BANK == 0 && nokFillByte(x, y / LCD_ROW_IN_BANK - 1) == 0)
+            y -= LCD_ROW_IN_BANK;
+        else
+            y--;
+    }
+    return y;
+}
+
+//-- grows a region run in column x from y down to its last row. clear banks are taken in one read
+static unsigned char nokFillBottom(unsigned char x, unsigned char y){
+    unsigned char h = nokLcdHeight();
+
+    while (y < h - 1 && !nokFillIsSet(x, y + 1)){
+        if (y % LCD_ROW_IN_BANK == LCD_ROW_IN_BANK - 1 && y + LCD_ROW_IN_BANK < h
+                && nokFillByte(x, y / LCD_ROW_IN_BANK + 1) == 0)
+            y += LCD_ROW_IN_BANK;
+        else
+            y++;
+    }
+    return y;
+}
+
+//-- explores the segments on the stack until it is empty
+static void nokFillDrain(unsigned char colour){
+    unsigned char h = nokLcdHeight();
+    unsigned char x, y, lo, hi, top, bot;
+    signed char dx;
+    FILL_SEG seg;
+
+    while (fillSp){
+        seg = fillStack[--fillSp];
+        x = seg.x;
+        dx = seg.dx;
+        lo = seg.lo;
+        hi = seg.hi;
+        if (fillConn == 8){                     // diagonal neighbours of the span ends
+            if (lo > 0)
+                lo--;
+            if (hi < h - 1)
+                hi++;
+        }
+
+        // every region run touching lo..hi. runs can leak past either end
+        y = nokFillNext(x, lo, hi);
+        while (y <= hi){
+            top = (y == lo) ? nokFillTop(x, y) : y;
+            bot = nokFillBottom(x, y);
+            nokFillRun(x, top, bot, colour);    // the run now reads as outside the region
+
+            nokFillPush(x + dx, top, bot, dx);  // carry on in the same direction
+            if (top < seg.lo)                   // leaks turn back towards the parent column
+                nokFillPush(x - dx, top, seg.lo - 1, -dx);
+            if (bot > seg.hi)
+                nokFillPush(x - dx, seg.hi + 1, bot, -dx);
+
+            if (bot >= hi)
+                break;
+            y = nokFillNext(x, bot + 2, hi);    // bot + 1 is outside the region
+        }
+    }
+}
+
+//-- one pass over the screen after the stack overflowed. every region run next to a pixel this
+//-- fill has set is filled and explored from, which picks up where the dropped segments led
+static void nokFillRescan(unsigned char colour){
+    unsigned char w = nokLcdWidth(), h = nokLcdHeight();
+    unsigned char x, y, bot;
+
+    for (x = 0; x < w; x++){
+        y = nokFillNext(x, 0, h - 1);
+        while (y < h){                          // y is the top of a region run
+            bot = nokFillBottom(x, y);
+            if ((x > 0 && nokFillMapAny(x - 1, y, bot)) || (x < w - 1 && nokFillMapAny(x + 1, y, bot))){
+                nokFillRun(x, y, bot, colour);
+                nokFillPush(x + 1, y, bot, 1);
+                nokFillPush(x - 1, y, bot, -1);
+                nokFillDrain(colour);
+            }
+            if (bot >= h - 2)
+                break;
+            y = nokFillNext(x, bot + 2, h - 1);
+        }
+    }
+}
+
+/************************************************************************************
+* Function: nokLcdFill
+* - flood fills the region around (x, y) with colour. the region is every pixel reachable
+*   from the seed that has the seed's colour. segments wait on a FILL_STACK_SZ stack. if it
+*   overflows, the fill finishes with passes over the screen instead, so it always completes
+*   in fixed RAM and only gets slower.
+* argument:
+*   x, y    - seed point in logical coordinates
+*   conn    - 4 or 8 connected
+*   colour  - 1 set pixels, 0 clear them
+* return: 0 if filled, -1 if arguments are invalid
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokLcdFill(int x, int y, int conn, int colour){
+    unsigned char h = nokLcdHeight();
+    unsigned char top, bot;
+
+    if (x < 0 || y < 0 || x >= nokLcdWidth() || y >= h || (conn != 4 && conn != 8))
+        return -1;
+    colour = colour ? 1 : 0;
+
+    fillInv = (nokLcdGetByte(x, y / LCD_ROW_IN_BANK) >> (y % LCD_ROW_IN_BANK)) & 1 ? 0xFF : 0x00;
+    if ((fillInv != 0) == colour)
+        return 0;                               // seed already has the fill colour
+
+    fillSp = 0;
+    fillOverflow = 0;
+    fillConn = conn;
+    fillBanks = (h + LCD_ROW_IN_BANK - 1) / LCD_ROW_IN_BANK;
+    memset(fillMap, 0, sizeof(fillMap));
+
+    top = nokFillTop(x, y);
+    bot = nokFillBottom(x, y);
+    nokFillRun(x, top, bot, colour);
+    nokFillPush(x + 1, top, bot, 1);
+    nokFillPush(x - 1, top, bot, -1);
+    nokFillDrain(colour);
+
+    // each pass fills something or finds nothing left, another is only needed if it overflowed too
+    while (fillOverflow){
+        fillOverflow = 0;
+        nokFillRescan(colour);
+    }
+
+    nokLcdFlush();
+    return 0;
+}
+
+/************************************************************************************
+* Function: nokLcdFillRect
+* - fills the rectangle between two corners (inclusive) with colour. one masked byte write
+*   per column and bank, then one flush.
+* argument:
+*   x0, y0  - one corner
+*   x1, y1  - opposite corner
+*   colour  - 1 set pixels, 0 clear them
+* return: 0 if valid, -1 if not
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokLcdFillRect(int x0, int y0, int x1, int y1, int colour){
+    int t;
+
+    if (x0 > x1){ t = x0; x0 = x1; x1 = t; }
+    if (y0 > y1){ t = y0; y0 = y1; y1 = t; }
+    if (x0 < 0 || y0 < 0 || x1 >= nokLcdWidth() || y1 >= nokLcdHeight())
+        return -1;
+
+    for (t = x0; t <= x1; t++)
+        nokFillSpan(t, y0, y1, colour);
+    nokLcdFlush();
+    return 0;
+}
@@ -0,0 +1,63 @@
+/*************************************************************************************************
+ * nokFill.h
+ * - C interface file for region fills on the NOKIA 5110 LCD shadow RAM.
+ *   The flood fill runs on vertical spans because a bank byte holds 8 vertical pixels: a span
+ *   is filled with one masked byte write per bank and clear/set banks are skipped a byte at a
+ *   time. Filled spans whose neighbour column still has to be explored go on a fixed size
+ *   stack (no recursion). When it is full the fill falls back to rescanning the screen against
+ *   a bitmap of what it has set, so it always completes. Everything is marked dirty and sent in
+ *   a single nokLcdFlush.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#ifndef NOKFILL_H_
+#define NOKFILL_H_
+
+#include "nok5110LCD.h"
+
+#define FILL_STACK_SZ   64      // segments. 4 bytes each, so 256 bytes of RAM
+#define FILL_MAP_SZ     (LCD_MAX_ROW * LCD_FB_BANKS)   // 528 bytes. 1 bit per pixel, 48 x 11 banks in portrait
+
+// a filled span lo..hi in column x - dx whose neighbours in column x are still to be explored
+typedef struct FILL_SEG {
+    unsigned char x;
+    unsigned char lo;
+    unsigned char hi;
+    signed char dx;             // +1 exploring right, -1 left
+}FILL_SEG;
+
+/************************************************************************************
+* Function: nokLcdFill
+* - flood fills the region around (x, y) with colour. the region is every pixel reachable
+*   from the seed that has the seed's colour. segments wait on a FILL_STACK_SZ stack. if it
+*   overflows, the fill finishes with passes over the screen instead, so it always completes
+*   in fixed RAM and only gets slower.
+* argument:
+*   x, y    - seed point in logical coordinates
+*   conn    - 4 or 8 connected
+*   colour  - 1 set pixels, 0 clear them
+* return: 0 if filled, -1 if arguments are invalid
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokLcdFill(int x, int y, int conn, int colour);
+
+/************************************************************************************
+* Function: nokLcdFillRect
+* - fills the rectangle between two corners (inclusive) with colour. one masked byte write
+*   per column and bank, then one flush.
+* argument:
+*   x0, y0  - one corner
+*   x1, y1  - opposite corner
+*   colour  - 1 set pixels, 0 clear them
+* return: 0 if valid, -1 if not
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokLcdFillRect(int x0, int y0, int x1, int y1, int colour);
+
+#endif /* NOKFILL_H_ */
@@ -0,0 +1,32 @@
+/*************************************************************************************************
+ * nokFont.h
+ * - C interface file for the 5x7 ASCII font used for text on the NOKIA 5110 LCD.
+ *   Each glyph is 5 column bytes, LSB at the top, so one glyph row fits exactly in a bank.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#ifndef NOKFONT_H_
+#define NOKFONT_H_
+
+#define NOK_FONT_FIRST      0x20        // ' '
+#define NOK_FONT_LAST       0x7F
+#define NOK_FONT_W          5           // glyph columns
+#define NOK_FONT_PITCH      6           // glyph plus one blank column. 84 / 6 = 14 chars per line
+
+extern const unsigned char nokFont5x7[NOK_FONT_LAST - NOK_FONT_FIRST + 1][NOK_FONT_W];
+
+/************************************************************************************
+* Function: nokFontGlyph
+* - glyph columns for a character. characters outside the font map to '?'
+* argument:
+*   c - ASCII character
+* return: pointer to NOK_FONT_W column bytes
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+const unsigned char* nokFontGlyph(char c);
+
+#endif /* NOKFONT_H_ */
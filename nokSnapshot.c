@@ -0,0 +1,135 @@
+/*************************************************************************************************
+ * nokSnapshot.c
+ * - C implementation or source file for exporting the LCD shadow RAM over UART A1.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+#include <stdio.h>
+
+#include "nokSnapshot.h"
+#include "usciUart.h"
+
+static const char snapB64[64] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// base64 encoder state. up to 2 bytes waiting for a third
+static unsigned long snapAcc;
+static unsigned char snapAccN;
+static unsigned char snapCol;               // chars on the current line
+static unsigned int snapOut;                // PackBits bytes encoded
+
+static unsigned char snapW;
+static unsigned int snapN;                  // bytes in the snapshot
+
+//-- snapshot byte i. banks in order, columns within a bank
+static unsigned char nokSnapByte(unsigned int i){
+    return nokLcdGetByte(i % snapW, i / snapW);
+}
+
+//-- one base64 char, breaking lines at SNAP_LINE_CHARS
+static void nokSnapChar(char c){
+    usciA1UartTxChar(c);
+    if (++snapCol == SNAP_LINE_CHARS){
+        usciA1UartTxString("\r\n");
+        snapCol = 0;
+    }
+}
+
+//-- emits 4 chars for the bytes in the accumulator. short groups are padded with '='
+static void nokSnapDrain(void){
+    unsigned char i;
+
+    snapAcc <<= 8 * (3 - snapAccN);
+    for (i = 0; i < 4; i++)
+        nokSnapChar(i <= snapAccN ? snapB64[(snapAcc >> (18 - 6 * i)) & 0x3F] : '=');
+    snapAcc = 0;
+    snapAccN = 0;
+}
+
+//-- one PackBits byte into the base64 stream
+static void nokSnapPut(unsigned char b){
+    snapAcc = (snapAcc << 8) | b;
+    snapOut++;
+    if (++snapAccN == 3)
+        nokSnapDrain();
+}
+
+//-- CRC-16/CCITT-FALSE step
+static unsigned int nokSnapCrc(unsigned int crc, unsigned char b){
+    unsigned char i;
+
+    crc ^= (unsigned int)b << 8;
+    for (i = 0; i < 8; i++)
+        crc = ((crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1) & 0xFFFF;
+    return crc;
+}
+
+//-- length of the run of equal bytes starting at i, at most SNAP_MAX_LITERAL
+static unsigned int nokSnapRun(unsigned int i){
+    unsigned char b = nokSnapByte(i);
+    unsigned int n = 1;
+
+    while (i + n < snapN && n < SNAP_MAX_LITERAL && nokSnapByte(i + n) == b)
+        n++;
+    return n;
+}
+
+/************************************************************************************
+* Function: nokSnapshotSend
+* - sends the shadow RAM as a compressed, base64 framed snapshot over UART A1 (format in
+*   nokSnapshot.h)
+* argument: none
+* return: number of PackBits bytes sent (before base64)
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned int nokSnapshotSend(void){
+    char line[32];
+    unsigned int i, n, run, crc = 0xFFFF;
+    unsigned char h = nokLcdHeight();
+
+    snapW = nokLcdWidth();
+    snapN = snapW * ((h + LCD_ROW_IN_BANK - 1) / LCD_ROW_IN_BANK);
+    snapAcc = 0;
+    snapAccN = 0;
+    snapCol = 0;
+    snapOut = 0;
+
+    sprintf(line, "@SNAP %u %u\r\n", snapW, h);
+    usciA1UartTxString(line);
+
+    // mostly blank screens compress to a few runs. the shadow RAM is read twice instead of copied
+    i = 0;
+    while (i < snapN){
+        run = nokSnapRun(i);
+        if (run >= SNAP_MIN_RUN){
+            nokSnapPut((unsigned char)(257 - run));
+            nokSnapPut(nokSnapByte(i));
+            for (n = 0; n < run; n++)
+                crc = nokSnapCrc(crc, nokSnapByte(i));
+            i += run;
+            continue;
+        }
+        // literal up to the next run worth encoding
+        n = 0;
+        while (i + n < snapN && n < SNAP_MAX_LITERAL && (n == 0 || nokSnapRun(i + n) < SNAP_MIN_RUN))
+            n++;
+        nokSnapPut((unsigned char)(n - 1));
+        for (run = 0; run < n; run++){
+            nokSnapPut(nokSnapByte(i + run));
+            crc = nokSnapCrc(crc, nokSnapByte(i + run));
+        }
+        i += n;
+    }
+    if (snapAccN)
+        nokSnapDrain();
+    if (snapCol)
+        usciA1UartTxString("\r\n");
+
+    sprintf(line, "@END %u %04X\r\n", snapOut, crc);
+    usciA1UartTxString(line);
+    return snapOut;
+}
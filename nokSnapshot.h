@@ -0,0 +1,48 @@
+/*************************************************************************************************
+ * nokSnapshot.h
+ * - C interface file for exporting the LCD shadow RAM over UART A1.
+ *   The PCD8544 cannot be read back, so the snapshot comes from the shadow RAM and shows the
+ *   logical (rotated) screen. It is PackBits compressed and sent as base64 text, so it can be
+ *   captured from the same terminal that sends commands.
+ *
+ *   Frame:
+ *     @SNAP <width> <height>\r\n
+ *     base64 lines, SNAP_LINE_CHARS chars each (the last one may be shorter)\r\n
+ *     @END <encoded bytes> <crc>\r\n
+ *   crc is CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) of the decoded bytes, 4 hex digits.
+ *
+ *   Decoding: base64 decode the lines, then PackBits:
+ *     n = 0..127    copy the next n + 1 bytes
+ *     n = 129..255  repeat the next byte 257 - n times
+ *     n = 128       not used
+ *   The result is ceil(height / 8) banks of width bytes, bank 0 first. Each byte holds 8
+ *   vertical pixels of one column, bit 0 on top, 1 = dark. For a PBM (P4) write the header
+ *   "P4\n<width> <height>\n", then for each row y the bits (byte[y / 8][x] >> (y % 8)) & 1
+ *   packed MSB first, each row padded to a whole byte.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#ifndef NOKSNAPSHOT_H_
+#define NOKSNAPSHOT_H_
+
+#include "nok5110LCD.h"
+
+#define SNAP_LINE_CHARS     64      // base64 chars per line. 48 encoded bytes
+#define SNAP_MAX_LITERAL    128     // longest PackBits literal or run
+#define SNAP_MIN_RUN        3       // shorter repeats stay inside a literal
+
+/************************************************************************************
+* Function: nokSnapshotSend
+* - sends the shadow RAM as a compressed, base64 framed snapshot over UART A1 (format in
+*   nokSnapshot.h)
+* argument: none
+* return: number of PackBits bytes sent (before base64)
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned int nokSnapshotSend(void);
+
+#endif /* NOKSNAPSHOT_H_ */
@@ -0,0 +1,276 @@
+/*************************************************************************************************
+ * nokSprite.c
+ * - C implementation or source file for the 8x8 sprite layer on the NOKIA 5110 LCD.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+#include <stdio.h>
+
+#include "nokSprite.h"
+#include "nokFill.h"
+#include "events.h"
+#include "timerB0.h"
+#include "usciSpi.h"
+#include "usciUart.h"
+
+static SPRITE sprites[SPRITE_MAX];
+
+// demo bitmaps. one byte per column, bit 0 on top
+static const unsigned char spriteBall[SPRITE_W] = {0x3C, 0x7E, 0xFF, 0xFF, 0xFF, 0xFF, 0x7E, 0x3C};
+static const unsigned char spriteRing[SPRITE_W] = {0x3C, 0x42, 0x81, 0x81, 0x81, 0x81, 0x42, 0x3C};
+static const unsigned char spriteCross[SPRITE_W] = {0x81, 0x42, 0x24, 0x18, 0x18, 0x24, 0x42, 0x81};
+static const unsigned char spriteBox[SPRITE_W] = {0xFF, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0xFF};
+
+//-- first bank and bit shift of a sprite at row y. y can be up to 7 rows above the screen
+static void nokSpriteBank(int y, int* bank, unsigned char* shift){
+    *bank = (y + LCD_ROW_IN_BANK) / LCD_ROW_IN_BANK - 1;
+    *shift = (y + LCD_ROW_IN_BANK) % LCD_ROW_IN_BANK;
+}
+
+//-- puts the saved bytes back under sprite s
+static void nokSpriteErase(SPRITE* s){
+    int bank, x;
+    unsigned char shift, c, b;
+
+    nokSpriteBank(s->drawnY, &bank, &shift);
+    for (c = 0; c < SPRITE_W; c++){
+        x = s->drawnX + c;
+        if (x < 0 || x >= nokLcdWidth())
+            continue;
+        for (b = 0; b < SPRITE_BANKS; b++)
+            if (bank + b >= 0)                      // nokLcdSetByte ignores banks below the screen
+                nokLcdSetByte(x, bank + b, s->saved[c][b]);
+    }
+    s->drawn = 0;
+}
+
+//-- saves the bytes under sprite s at its new position and composites it over them
+static void nokSpriteDraw(SPRITE* s){
+    int bank, x;
+    unsigned char shift, c, b, old, pix, msk;
+    unsigned int pix16, msk16;
+
+    nokSpriteBank(s->y, &bank, &shift);
+    for (c = 0; c < SPRITE_W; c++){
+        x = s->x + c;
+        if (x < 0 || x >= nokLcdWidth())
+            continue;
+        // the column byte split across the two banks it straddles
+        pix16 = (unsigned int)s->bitmap[c] << shift;
+        msk16 = (unsigned int)(s->mode == SPRITE_MASKED ? s->mask[c] : 0) << shift;
+        for (b = 0; b < SPRITE_BANKS; b++){
+            if (bank + b < 0)
+                continue;
+            old = nokLcdGetByte(x, bank + b);
+            s->saved[c][b] = old;
+            pix = (unsigned char)(pix16 >> (b * LCD_ROW_IN_BANK));
+            msk = (unsigned char)(msk16 >> (b * LCD_ROW_IN_BANK));
+            if (s->mode == SPRITE_MASKED)
+                nokLcdSetByte(x, bank + b, (old & ~msk) | (pix & msk));
+            else
+                nokLcdSetByte(x, bank + b, old ^ pix);
+        }
+    }
+    s->drawnX = s->x;
+    s->drawnY = s->y;
+    s->drawn = 1;
+}
+
+/************************************************************************************
+* Function: nokSpriteSet
+* - gives a sprite its bitmap and compositing mode. the sprite starts hidden at (0, 0).
+* argument:
+*   id      - 0 to SPRITE_MAX-1
+*   bitmap  - SPRITE_W column bytes
+*   mask    - SPRITE_W column bytes for SPRITE_MASKED, ignored for SPRITE_XOR
+*   mode    - SPRITE_XOR or SPRITE_MASKED
+* return: 0 if valid, -1 if not
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokSpriteSet(unsigned char id, const unsigned char* bitmap, const unsigned char* mask, unsigned char mode){
+    SPRITE* s;
+
+    if (id >= SPRITE_MAX || !bitmap || (mode == SPRITE_MASKED && !mask) || mode > SPRITE_MASKED)
+        return -1;
+    s = &sprites[id];
+    if (s->drawn)
+        nokSpriteErase(s);                  // the old bitmap is still on screen
+
+    s->bitmap = bitmap;
+    s->mask = mask;
+    s->mode = mode;
+    s->x = s->y = 0;
+    s->visible = 0;
+    return 0;
+}
+
+/************************************************************************************
+* Function: nokSpriteMove
+* - sets where a sprite is drawn by the next nokSpriteFrame
+* argument:
+*   id      - 0 to SPRITE_MAX-1
+*   x, y    - top left pixel in logical coordinates
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokSpriteMove(unsigned char id, int x, int y){
+    if (id >= SPRITE_MAX)
+        return;
+    // fully off screen is the same as hidden. keeping it within a sprite of the edge keeps bank math simple
+    if (x < -SPRITE_W) x = -SPRITE_W;
+    if (y < -LCD_ROW_IN_BANK) y = -LCD_ROW_IN_BANK;
+    if (x > nokLcdWidth()) x = nokLcdWidth();
+    if (y > nokLcdHeight()) y = nokLcdHeight();
+    sprites[id].x = x;
+    sprites[id].y = y;
+}
+
+/************************************************************************************
+* Function: nokSpriteShow
+* - shows or hides a sprite from the next nokSpriteFrame
+* argument:
+*   id      - 0 to SPRITE_MAX-1
+*   visible - 1 show, 0 hide
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokSpriteShow(unsigned char id, unsigned char visible){
+    if (id < SPRITE_MAX && sprites[id].bitmap)
+        sprites[id].visible = visible ? 1 : 0;
+}
+
+/************************************************************************************
+* Function: nokSpriteHideAll
+* - restores the background under every sprite now and hides them all. call before
+*   drawing into the background.
+* argument: none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokSpriteHideAll(void){
+    int i;
+
+    for (i = SPRITE_MAX - 1; i >= 0; i--){
+        if (sprites[i].drawn)
+            nokSpriteErase(&sprites[i]);
+        sprites[i].visible = 0;
+    }
+    nokLcdFlush();
+}
+
+/************************************************************************************
+* Function: nokSpriteFrame
+* - erases the sprites on screen (last drawn first), draws the visible ones at their new
+*   positions and flushes
+* argument: none
+* return: LCD bus bytes sent by the flush
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned int nokSpriteFrame(void){
+    int i;
+
+    // reverse order so overlapping sprites give back exactly the background they covered
+    for (i = SPRITE_MAX - 1; i >= 0; i--)
+        if (sprites[i].drawn)
+            nokSpriteErase(&sprites[i]);
+    for (i = 0; i < SPRITE_MAX; i++)
+        if (sprites[i].visible)
+            nokSpriteDraw(&sprites[i]);
+
+    // a sprite that did not move writes back the same bytes, so it costs nothing on the bus
+    return nokLcdFlush();
+}
+
+/************************************************************************************
+* Function: nokSpriteDemo
+* - bounces SPRITE_MAX sprites over a test background for nFrames frames, one frame per
+*   timerB0 tick. reports the frame rate sustained, bus bytes and work time per frame, and
+*   the frame rate the bus and the CPU could each sustain, over UART A1
+* argument:
+*   nFrames - frames to run, at least 1
+*   tickHz  - frame tick rate, at least 1
+* return: 0 if run, -1 if nFrames or tickHz is 0
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokSpriteDemo(unsigned int nFrames, unsigned int tickHz){
+    static const unsigned char* const shapes[] = {spriteBall, spriteRing, spriteCross, spriteBox};
+    signed char dx[SPRITE_MAX], dy[SPRITE_MAX];
+    char line[80];
+    unsigned char defer;
+    unsigned char w = nokLcdWidth();
+    unsigned char h = nokLcdHeight();
+    unsigned long bytes = 0, work = 0, t0, tFrame;
+    unsigned long us, workUs, bytesPerFrame;
+    unsigned int f;
+    unsigned char i;
+
+    if (nFrames == 0 || tickHz == 0)
+        return -1;
+    defer = nokLcdDeferFlush(0);                // every frame goes out on its own tick
+
+    // background: a filled block and a diagonal, so both compositing modes show
+    nokSpriteHideAll();
+    nokLcdClear();
+    nokLcdFillRect(w / 4, h / 4, w / 2, (3 * h) / 4, 1);
+    nokLcdDrawLine(0, h - 1, w - 1, 0);
+
+    for (i = 0; i < SPRITE_MAX; i++){
+        // ball is masked (a hole is cut in the block), the outlines are XOR
+        nokSpriteSet(i, shapes[i % 4], shapes[i % 4], (i % 4 == 0) ? SPRITE_MASKED : SPRITE_XOR);
+        nokSpriteMove(i, (i * 10) % (w - SPRITE_W), (i * 5) % (h - SPRITE_W));
+        nokSpriteShow(i, 1);
+        dx[i] = (i & 1) ? 1 : -1;
+        dy[i] = (i & 2) ? 1 : -1;
+    }
+
+    timerB0TickStart(tickHz);
+    eventWait(EVT_TICK);                        // line the frames up with the tick
+    t0 = timerB0Now();
+    for (f = 0; f < nFrames; f++){
+        tFrame = timerB0Now();
+        for (i = 0; i < SPRITE_MAX; i++){
+            if (sprites[i].x + dx[i] < 0 || sprites[i].x + dx[i] > w - SPRITE_W)
+                dx[i] = -dx[i];
+            if (sprites[i].y + dy[i] < 0 || sprites[i].y + dy[i] > h - SPRITE_W)
+                dy[i] = -dy[i];
+            nokSpriteMove(i, sprites[i].x + dx[i], sprites[i].y + dy[i]);
+        }
+        bytes += nokSpriteFrame();
+        work += timerB0Now() - tFrame;
+        eventWait(EVT_TICK);                    // LPM0 for the rest of the frame
+    }
+    us = timerB0TicksToUs(timerB0Now() - t0);
+    timerB0TickStop();
+
+    workUs = timerB0TicksToUs(work) / nFrames;
+    bytesPerFrame = bytes / nFrames;
+    sprintf(line, "%u frames %lu us %lu.%lu fps\r\n", nFrames, us,
+            us ? (unsigned long)((unsigned long long)nFrames * 1000000UL / us) : 0,
+            us ? (unsigned long)((unsigned long long)nFrames * 10000000UL / us) % 10 : 0);
+    usciA1UartTxString(line);
+    sprintf(line, "per frame: %lu bus bytes (full screen %u) %lu us work\r\n", bytesPerFrame,
+            LCD_MAX_COL * LCD_MAX_BANK, workUs);
+    usciA1UartTxString(line);
+    sprintf(line, "ceiling: bus %lu fps cpu %lu fps\r\n",
+            bytesPerFrame ? usciB1SpiSclkHz() / (8UL * bytesPerFrame) : 0,
+            workUs ? 1000000UL / workUs : 0);
+    usciA1UartTxString(line);
+
+    nokLcdDeferFlush(defer);
+    return 0;
+}
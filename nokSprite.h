@@ -0,0 +1,117 @@
+/*************************************************************************************************
+ * nokSprite.h
+ * - C interface file for the 8x8 sprite layer on the NOKIA 5110 LCD.
+ *   Sprites are composited over whatever is in the shadow RAM (the background). Each sprite
+ *   saves the bytes under its footprint before drawing, so a frame erases the sprites in
+ *   reverse order, draws them at their new positions and flushes. Only bytes that changed
+ *   are marked dirty, so the bus carries the old and new footprints and nothing else.
+ *   Draw the background with every sprite hidden (nokSpriteHideAll) or the restore undoes it.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#ifndef NOKSPRITE_H_
+#define NOKSPRITE_H_
+
+#include "nok5110LCD.h"
+
+#define SPRITE_MAX      8           // sprites
+#define SPRITE_W        8           // columns per bitmap. one byte per column, bit 0 on top
+#define SPRITE_BANKS    2           // an 8 row sprite not aligned to a bank touches 2 banks
+
+#define SPRITE_XOR      0           // pixels invert the background
+#define SPRITE_MASKED   1           // mask bits take the bitmap's pixels, the rest keep the background
+
+typedef struct SPRITE {
+    const unsigned char* bitmap;    // SPRITE_W column bytes
+    const unsigned char* mask;      // SPRITE_W column bytes, SPRITE_MASKED only
+    int x, y;                       // position for the next frame, top left. may be partly off screen
+    int drawnX, drawnY;             // position on screen
+    unsigned char mode;             // SPRITE_XOR or SPRITE_MASKED
+    unsigned char visible;          // shown from the next frame
+    unsigned char drawn;            // on screen and saved holds the bytes under it
+    unsigned char saved[SPRITE_W][SPRITE_BANKS];
+}SPRITE;
+
+/************************************************************************************
+* Function: nokSpriteSet
+* - gives a sprite its bitmap and compositing mode. the sprite starts hidden at (0, 0).
+* argument:
+*   id      - 0 to SPRITE_MAX-1
+*   bitmap  - SPRITE_W column bytes
+*   mask    - SPRITE_W column bytes for SPRITE_MASKED, ignored for SPRITE_XOR
+*   mode    - SPRITE_XOR or SPRITE_MASKED
+* return: 0 if valid, -1 if not
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokSpriteSet(unsigned char id, const unsigned char* bitmap, const unsigned char* mask, unsigned char mode);
+
+/************************************************************************************
+* Function: nokSpriteMove
+* - sets where a sprite is drawn by the next nokSpriteFrame
+* argument:
+*   id      - 0 to SPRITE_MAX-1
+*   x, y    - top left pixel in logical coordinates
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokSpriteMove(unsigned char id, int x, int y);
+
+/************************************************************************************
+* Function: nokSpriteShow
+* - shows or hides a sprite from the next nokSpriteFrame
+* argument:
+*   id      - 0 to SPRITE_MAX-1
+*   visible - 1 show, 0 hide
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokSpriteShow(unsigned char id, unsigned char visible);
+
+/************************************************************************************
+* Function: nokSpriteHideAll
+* - restores the background under every sprite now and hides them all. call before
+*   drawing into the background.
+* argument: none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokSpriteHideAll(void);
+
+/************************************************************************************
+* Function: nokSpriteFrame
+* - erases the sprites on screen (last drawn first), draws the visible ones at their new
+*   positions and flushes
+* argument: none
+* return: LCD bus bytes sent by the flush
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned int nokSpriteFrame(void);
+
+/************************************************************************************
+* Function: nokSpriteDemo
+* - bounces SPRITE_MAX sprites over a test background for nFrames frames, one frame per
+*   timerB0 tick. reports the frame rate sustained, bus bytes and work time per frame, and
+*   the frame rate the bus and the CPU could each sustain, over UART A1
+* argument:
+*   nFrames - frames to run, at least 1
+*   tickHz  - frame tick rate, at least 1
+* return: 0 if run, -1 if nFrames or tickHz is 0
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokSpriteDemo(unsigned int nFrames, unsigned int tickHz);
+
+#endif /* NOKSPRITE_H_ */
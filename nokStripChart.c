@@ -0,0 +1,180 @@
+/*************************************************************************************************
+ * nokStripChart.c
+ * - C implementation or source file for the streaming strip chart on the NOKIA 5110 LCD.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+#include <stdio.h>
+
+#include "nokStripChart.h"
+#include "timerB0.h"
+#include "usciUart.h"
+
+static int stripMin = 0;
+static int stripMax = LCD_MAX_ROW - 1;
+static unsigned char stripMode = STRIP_SCROLL;
+static unsigned char stripW = LCD_MAX_COL;      // chart size, taken from the rotation at nokStripInit
+static unsigned char stripH = LCD_MAX_ROW;
+
+// circular column buffer. stripHead is the slot the next sample goes into
+static unsigned char stripLo[LCD_MAX_COL];      // top row of each column's span
+static unsigned char stripHi[LCD_MAX_COL];      // bottom row of each column's span
+static unsigned char stripHead = 0;
+static unsigned char stripCount = 0;            // columns in use, saturates at stripW
+static unsigned char stripPrevY = 0;
+
+//-- bank byte for a vertical span of rows lo..hi
+static unsigned char nokStripMask(unsigned char lo, unsigned char hi, unsigned char bank){
+    unsigned char top = bank * LCD_ROW_IN_BANK;
+    unsigned char bot = top + LCD_ROW_IN_BANK - 1;
+
+    if (hi < top || lo > bot)
+        return 0;
+    if (lo < top) lo = top;
+    if (hi > bot) hi = bot;
+    return (unsigned char)((0xFF << (lo - top)) & (0xFF >> (bot - hi)));
+}
+
+//-- writes ring slot into screen column x. a slot past stripCount draws a blank column
+static void nokStripDrawColumn(unsigned char x, unsigned char slot, unsigned char blank){
+    unsigned char bank;
+
+    for (bank = 0; bank * LCD_ROW_IN_BANK < stripH; bank++)
+        nokLcdSetByte(x, bank, blank ? 0 : nokStripMask(stripLo[slot], stripHi[slot], bank));
+}
+
+/************************************************************************************
+* Function: nokStripInit
+* - clears the screen and starts an empty chart. vMax plots on the top row, vMin on the bottom.
+* argument:
+*   vMin - sample value at the bottom row
+*   vMax - sample value at the top row. must be greater than vMin
+*   mode - STRIP_SCROLL or STRIP_SWEEP
+* return: 0 if valid, -1 if not
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokStripInit(int vMin, int vMax, unsigned char mode){
+    unsigned char x;
+
+    if (vMax <= vMin || (mode != STRIP_SCROLL && mode != STRIP_SWEEP))
+        return -1;
+
+    stripMin = vMin;
+    stripMax = vMax;
+    stripMode = mode;
+    stripW = nokLcdWidth();
+    stripH = nokLcdHeight();
+    stripHead = 0;
+    stripCount = 0;
+
+    for (x = 0; x < stripW; x++)
+        nokStripDrawColumn(x, 0, 1);
+    nokLcdFlush();
+    return 0;
+}
+
+/************************************************************************************
+* Function: nokStripPush
+* - adds one sample to the chart in the shadow RAM. values outside vMin..vMax are clamped.
+*   call nokLcdFlush to send it, or use nokStripPlot. pushing several samples before one
+*   flush batches them into a single burst.
+* argument:
+*   sample - new value
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokStripPush(int sample){
+    unsigned char y, x, slot;
+
+    if (sample < stripMin) sample = stripMin;
+    if (sample > stripMax) sample = stripMax;
+    // row 0 is the top of the screen, so larger values get smaller rows. the differences are
+    // taken in long: vMax - vMin does not fit an int when the range spans more than 32767
+    y = (unsigned char)((((long)stripMax - sample) * (stripH - 1)) / ((long)stripMax - stripMin));
+
+    // connect to the previous sample with a vertical span. the first sample is a single dot
+    if (stripCount == 0)
+        stripPrevY = y;
+    slot = stripHead;
+    stripLo[slot] = (y < stripPrevY) ? y : stripPrevY;
+    stripHi[slot] = (y < stripPrevY) ? stripPrevY : y;
+    stripPrevY = y;
+
+    stripHead = (stripHead + 1) % stripW;
+    if (stripCount < stripW)
+        stripCount++;
+
+    if (stripMode == STRIP_SWEEP){
+        // the ring slot is the screen column. draw it and blank the column ahead as the gap
+        nokStripDrawColumn(slot, slot, 0);
+        nokStripDrawColumn(stripHead, stripHead, 1);
+    }
+    else if (stripCount < stripW){
+        nokStripDrawColumn(slot, slot, 0);          // still filling the screen left to right
+    }
+    else {
+        // full: oldest column (stripHead) on the left. only bytes that change are resent
+        for (x = 0; x < stripW; x++)
+            nokStripDrawColumn(x, (stripHead + x) % stripW, 0);
+    }
+}
+
+/************************************************************************************
+* Function: nokStripPlot
+* - nokStripPush followed by nokLcdFlush
+* argument:
+*   sample - new value
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokStripPlot(int sample){
+    nokStripPush(sample);
+    nokLcdFlush();
+}
+
+/************************************************************************************
+* Function: nokStripBench
+* - plots nSamples of a triangle wave, one flush per sample, and reports samples per
+*   second and LCD bus bytes per sample over UART A1
+* argument:
+*   nSamples - number of samples to plot
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokStripBench(unsigned int nSamples){
+    char line[64];
+    unsigned long bytes0 = nokLcdBusBytes();
+    unsigned long t0 = timerB0Now();
+    unsigned long us;
+    unsigned int i;
+    long v = stripMin;
+    long dv = ((long)stripMax - stripMin) / 16 + 1;
+    unsigned char defer = nokLcdDeferFlush(0);     // measure real flushes even when run by the scheduler
+
+    for (i = 0; i < nSamples; i++){
+        nokStripPlot((int)v);
+        v += dv;
+        if (v >= stripMax || v <= stripMin){
+            v = (v >= stripMax) ? stripMax : stripMin;  // keeps v an int when the range is near full scale
+            dv = -dv;
+        }
+    }
+
+    us = timerB0TicksToUs(timerB0Now() - t0);
+    sprintf(line, "%u samples %lu us %lu samples/s %lu bytes/sample\r\n", nSamples, us,
+            us ? (unsigned long)((unsigned long long)nSamples * 1000000UL / us) : 0,
+            nSamples ? (nokLcdBusBytes() - bytes0) / nSamples : 0);
+    usciA1UartTxString(line);
+    nokLcdDeferFlush(defer);
+}
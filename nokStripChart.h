@@ -0,0 +1,75 @@
+/*************************************************************************************************
+ * nokStripChart.h
+ * - C interface file for the streaming strip chart on the NOKIA 5110 LCD.
+ *   Every sample becomes one column holding a vertical span from the previous sample's row to
+ *   its own row, so the trace stays connected. Columns live in a circular buffer.
+ *   STRIP_SCROLL: the plot scrolls left. every byte that changes is resent in one burst.
+ *   STRIP_SWEEP : the write column moves right and wraps (circular column addressing), with a
+ *                 blank gap column ahead of it. a sample costs one column write.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#ifndef NOKSTRIPCHART_H_
+#define NOKSTRIPCHART_H_
+
+#include "nok5110LCD.h"
+
+#define STRIP_SCROLL    0
+#define STRIP_SWEEP     1
+
+/************************************************************************************
+* Function: nokStripInit
+* - clears the screen and starts an empty chart. vMax plots on the top row, vMin on the bottom.
+* argument:
+*   vMin - sample value at the bottom row
+*   vMax - sample value at the top row. must be greater than vMin
+*   mode - STRIP_SCROLL or STRIP_SWEEP
+* return: 0 if valid, -1 if not
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokStripInit(int vMin, int vMax, unsigned char mode);
+
+/************************************************************************************
+* Function: nokStripPush
+* - adds one sample to the chart in the shadow RAM. values outside vMin..vMax are clamped.
+*   call nokLcdFlush to send it, or use nokStripPlot. pushing several samples before one
+*   flush batches them into a single burst.
+* argument:
+*   sample - new value
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokStripPush(int sample);
+
+/************************************************************************************
+* Function: nokStripPlot
+* - nokStripPush followed by nokLcdFlush
+* argument:
+*   sample - new value
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokStripPlot(int sample);
+
+/************************************************************************************
+* Function: nokStripBench
+* - plots nSamples of a triangle wave, one flush per sample, and reports samples per
+*   second and LCD bus bytes per sample over UART A1
+* argument:
+*   nSamples - number of samples to plot
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokStripBench(unsigned int nSamples);
+
+#endif /* NOKSTRIPCHART_H_ */
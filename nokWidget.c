@@ -0,0 +1,446 @@
+/*************************************************************************************************
+ * nokWidget.c
+ * - C implementation or source file for retained dashboard widgets on the NOKIA 5110 LCD.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "nokWidget.h"
+#include "nokFont.h"
+#include "timerB0.h"
+#include "usciUart.h"
+
+// sin of k * 180 / WIDGET_GAUGE_STEPS degrees for the first quarter, 256 = 1
+static const unsigned int widgetSin[WIDGET_GAUGE_STEPS / 2 + 1] = {
+    0, 13, 25, 38, 50, 62, 74, 86, 98, 109, 121, 132, 142, 152, 162, 172, 181,
+    190, 198, 206, 213, 220, 226, 231, 237, 241, 245, 248, 251, 253, 255, 256, 256
+};
+
+static NOK_WIDGET widgets[WIDGET_MAX];
+
+//-- n / d rounded to the nearest integer. d > 0
+static int nokWidgetDiv(int n, int d){
+    return (n >= 0) ? (n + d / 2) / d : -((-n + d / 2) / d);
+}
+
+//-- bank byte for the rows lo..hi. nothing when lo > hi
+static unsigned char nokWidgetMask(int lo, int hi, unsigned char bank){
+    int top = bank * LCD_ROW_IN_BANK;
+    int bot = top + LCD_ROW_IN_BANK - 1;
+
+    if (lo > hi || hi < top || lo > bot)
+        return 0;
+    if (lo < top) lo = top;
+    if (hi > bot) hi = bot;
+    return (unsigned char)((0xFF << (lo - top)) & (0xFF >> (bot - hi)));
+}
+
+//-- swaps the widget's old pixels in a bank byte for its new ones
+static void nokWidgetPut(unsigned char x, unsigned char bank, unsigned char oldBits, unsigned char newBits){
+    if (oldBits != newBits)
+        nokLcdSetByte(x, bank, (nokLcdGetByte(x, bank) & ~oldBits) | newBits);
+}
+
+//-- column x goes from rows oldLo..oldHi to rows newLo..newHi. an empty span has lo > hi
+static void nokWidgetSpan(unsigned char x, int oldLo, int oldHi, int newLo, int newHi){
+    int lo = newLo, hi = newHi, bank;
+
+    if (oldLo <= oldHi){
+        if (newLo > newHi || oldLo < lo) lo = oldLo;
+        if (newLo > newHi || oldHi > hi) hi = oldHi;
+    }
+    if (lo > hi)
+        return;
+    for (bank = lo / LCD_ROW_IN_BANK; bank <= hi / LCD_ROW_IN_BANK; bank++)
+        nokWidgetPut(x, bank, nokWidgetMask(oldLo, oldHi, bank), nokWidgetMask(newLo, newHi, bank));
+}
+
+//-- 8 rows of column x from row y down. a y off the bank grid splits over two banks
+static void nokWidgetBits(unsigned char x, unsigned char y, unsigned char oldBits, unsigned char newBits){
+    unsigned char bank = y / LCD_ROW_IN_BANK;
+    unsigned char s = y % LCD_ROW_IN_BANK;
+
+    nokWidgetPut(x, bank, (unsigned char)(oldBits << s), (unsigned char)(newBits << s));
+    if (s)
+        nokWidgetPut(x, bank + 1, oldBits >> (LCD_ROW_IN_BANK - s), newBits >> (LCD_ROW_IN_BANK - s));
+}
+
+//-- rows of column x the line (x0,y0)-(x1,y1) covers. lo > hi when x is off the line.
+//   the line is sampled at the column edges, so neighbouring columns meet and it stays connected
+static void nokWidgetLineSpan(int x0, int y0, int x1, int y1, int x, int* lo, int* hi){
+    int t, ya, yb;
+
+    if (x0 > x1){
+        t = x0; x0 = x1; x1 = t;
+        t = y0; y0 = y1; y1 = t;
+    }
+    *lo = 1;
+    *hi = 0;
+    if (x < x0 || x > x1)
+        return;
+    if (x0 == x1){
+        ya = y0;
+        yb = y1;
+    }
+    else {
+        ya = y0 + nokWidgetDiv((y1 - y0) * (2 * (x - x0) - 1), 2 * (x1 - x0));
+        yb = y0 + nokWidgetDiv((y1 - y0) * (2 * (x - x0) + 1), 2 * (x1 - x0));
+    }
+    *lo = (ya < yb) ? ya : yb;
+    *hi = (ya < yb) ? yb : ya;
+    t = (y0 < y1) ? y0 : y1;                    // the end columns stop at the end points
+    if (*lo < t) *lo = t;
+    t = (y0 < y1) ? y1 : y0;
+    if (*hi > t) *hi = t;
+}
+
+//-- glyph column c of a digit cell. the last column is the blank spacing
+static unsigned char nokWidgetGlyphCol(char ch, unsigned char c){
+    return (c < NOK_FONT_W) ? nokFontGlyph(ch)[c] : 0;
+}
+
+//-- half circle of radius r above (cx, cy), midpoint circle
+static void nokWidgetArc(int cx, int cy, int r){
+    int dx = 0, dy = r, d = 1 - r;
+
+    while (dx <= dy){
+        nokLcdPlot(cx + dx, cy - dy);
+        nokLcdPlot(cx - dx, cy - dy);
+        nokLcdPlot(cx + dy, cy - dx);
+        nokLcdPlot(cx - dy, cy - dx);
+        if (d < 0)
+            d += 2 * dx + 3;
+        else {
+            d += 2 * (dx - dy) + 5;
+            dy--;
+        }
+        dx++;
+    }
+}
+
+//-- bar length or needle step for the widget's value. long before subtracting: a 16 bit int
+//   overflows for ranges wider than 32767
+static int nokWidgetScale(NOK_WIDGET* wg, int range){
+    return (int)((((long)wg->value - wg->vMin) * range) / ((long)wg->vMax - wg->vMin));
+}
+
+//-- brings the screen from what the widget last drew to its value.
+//   redraw treats the whole box as old pixels, which clears it first
+static void nokWidgetDraw(NOK_WIDGET* wg, unsigned char redraw){
+    char text[8];
+    int c, from, to, a, sinA, cosA, len, oLo, oHi, nLo, nHi;
+    unsigned char fill, tipX, tipY, i;
+
+    switch (wg->type){
+    case WIDGET_HBAR:
+        // columns between the old and the new end flip between empty and full
+        fill = nokWidgetScale(wg, wg->w);
+        from = redraw ? 0 : ((fill < wg->fill) ? fill : wg->fill);
+        to = redraw ? wg->w : ((fill < wg->fill) ? wg->fill : fill);
+        for (c = from; c < to; c++)
+            nokWidgetSpan(wg->x + c, (redraw || c < wg->fill) ? wg->y : wg->y + wg->h, wg->y + wg->h - 1,
+                          (c < fill) ? wg->y : wg->y + wg->h, wg->y + wg->h - 1);
+        wg->fill = fill;
+        break;
+
+    case WIDGET_VBAR:
+        // every column changes, but only in the banks the top edge moved through
+        fill = nokWidgetScale(wg, wg->h);
+        if (!redraw && fill == wg->fill)
+            break;
+        for (c = 0; c < wg->w; c++)
+            nokWidgetSpan(wg->x + c, redraw ? wg->y : wg->y + wg->h - wg->fill, wg->y + wg->h - 1,
+                          wg->y + wg->h - fill, wg->y + wg->h - 1);
+        wg->fill = fill;
+        break;
+
+    case WIDGET_GAUGE:
+        // a = angle in steps, WIDGET_GAUGE_STEPS is the left end (vMin)
+        a = WIDGET_GAUGE_STEPS - nokWidgetScale(wg, WIDGET_GAUGE_STEPS);
+        sinA = widgetSin[(a <= WIDGET_GAUGE_STEPS / 2) ? a : WIDGET_GAUGE_STEPS - a];
+        cosA = (a <= WIDGET_GAUGE_STEPS / 2) ? (int)widgetSin[WIDGET_GAUGE_STEPS / 2 - a]
+                                             : -(int)widgetSin[a - WIDGET_GAUGE_STEPS / 2];
+        len = wg->w - 2;
+        tipX = wg->x + nokWidgetDiv(cosA * len, 256);
+        tipY = wg->y - nokWidgetDiv(sinA * len, 256);
+
+        if (redraw){
+            for (c = wg->x - wg->w; c <= wg->x + wg->w; c++)
+                nokWidgetSpan(c, wg->y - wg->w, wg->y, 1, 0);
+            nokWidgetArc(wg->x, wg->y, wg->w);
+            wg->tipX = wg->tipY = 0;
+        }
+        else if (tipX == wg->tipX && tipY == wg->tipY)
+            break;
+
+        // only the columns either needle crosses
+        from = to = wg->x;
+        if (!redraw){
+            if (wg->tipX < from) from = wg->tipX;
+            if (wg->tipX > to) to = wg->tipX;
+        }
+        if (tipX < from) from = tipX;
+        if (tipX > to) to = tipX;
+        for (c = from; c <= to; c++){
+            oLo = 1; oHi = 0;
+            if (!redraw)
+                nokWidgetLineSpan(wg->x, wg->y, wg->tipX, wg->tipY, c, &oLo, &oHi);
+            nokWidgetLineSpan(wg->x, wg->y, tipX, tipY, c, &nLo, &nHi);
+            nokWidgetSpan(c, oLo, oHi, nLo, nHi);
+        }
+        wg->tipX = tipX;
+        wg->tipY = tipY;
+        break;
+
+    case WIDGET_NUMBER:
+        // only the digits that differ. a changed digit still skips its unchanged columns
+        sprintf(text, "%*d", wg->w, wg->value);
+        if (strlen(text) > wg->w){
+            memset(text, '*', wg->w);
+            text[wg->w] = NULL_CHAR;
+        }
+        for (i = 0; i < wg->w; i++){
+            if (!redraw && text[i] == wg->text[i])
+                continue;
+            for (c = 0; c < NOK_FONT_PITCH; c++)
+                nokWidgetBits(wg->x + i * NOK_FONT_PITCH + c, wg->y,
+                              redraw ? 0xFF : nokWidgetGlyphCol(wg->text[i], c), nokWidgetGlyphCol(text[i], c));
+        }
+        strcpy(wg->text, text);
+        break;
+
+    default:
+        break;
+    }
+}
+
+//-- takes a free slot and draws the widget at vMin
+static int nokWidgetAdd(unsigned char type, unsigned char x, unsigned char y, unsigned char w, unsigned char h,
+                        int vMin, int vMax){
+    unsigned char id;
+
+    if (vMax <= vMin)
+        return -1;
+    for (id = 0; id < WIDGET_MAX && widgets[id].type != WIDGET_NONE; id++)
+        ;
+    if (id == WIDGET_MAX)
+        return -1;
+
+    widgets[id].type = type;
+    widgets[id].x = x;
+    widgets[id].y = y;
+    widgets[id].w = w;
+    widgets[id].h = h;
+    widgets[id].vMin = vMin;
+    widgets[id].vMax = vMax;
+    widgets[id].value = (type == WIDGET_NUMBER) ? 0 : vMin;
+    nokWidgetDraw(&widgets[id], 1);
+    return id;
+}
+
+//-- bytes a flush of the whole widget box sends: data plus the X and Y address per bank
+static unsigned int nokWidgetFullBytes(NOK_WIDGET* wg){
+    int cols, top, bot;
+
+    switch (wg->type){
+    case WIDGET_GAUGE:
+        cols = 2 * wg->w + 1;
+        top = wg->y - wg->w;
+        bot = wg->y;
+        break;
+    case WIDGET_NUMBER:
+        cols = wg->w * NOK_FONT_PITCH;
+        top = wg->y;
+        bot = wg->y + LCD_ROW_IN_BANK - 1;
+        break;
+    default:
+        cols = wg->w;
+        top = wg->y;
+        bot = wg->y + wg->h - 1;
+        break;
+    }
+    return (bot / LCD_ROW_IN_BANK - top / LCD_ROW_IN_BANK + 1) * (cols + 2);
+}
+
+/************************************************************************************
+* Function: nokWidgetBar
+* - adds a bar and draws it empty (value vMin)
+* argument:
+*   x, y - top left
+*   w, h - size in pixels
+*   vMin, vMax - values for an empty and a full bar. vMax must be greater than vMin
+*   vertical - 1 fills bottom to top, 0 left to right
+* return: widget id, -1 if no slot is free, it does not fit the screen or vMax <= vMin
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokWidgetBar(unsigned char x, unsigned char y, unsigned char w, unsigned char h, int vMin, int vMax,
+                 unsigned char vertical){
+    if (w == 0 || h == 0 || x + w > nokLcdWidth() || y + h > nokLcdHeight())
+        return -1;
+    return nokWidgetAdd(vertical ? WIDGET_VBAR : WIDGET_HBAR, x, y, w, h, vMin, vMax);
+}
+
+/************************************************************************************
+* Function: nokWidgetGauge
+* - adds a needle gauge and draws the dial with the needle at vMin. the needle is r - 2 long
+*   so it never touches the dial.
+* argument:
+*   cx, cy - centre of the dial. the dial spans cx - r .. cx + r and cy - r .. cy
+*   r - radius, at least WIDGET_GAUGE_R_MIN
+*   vMin, vMax - values at the left and right end. vMax must be greater than vMin
+* return: widget id, -1 if no slot is free, it does not fit the screen or vMax <= vMin
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokWidgetGauge(unsigned char cx, unsigned char cy, unsigned char r, int vMin, int vMax){
+    if (r < WIDGET_GAUGE_R_MIN || cx < r || cy < r || cx + r >= nokLcdWidth() || cy >= nokLcdHeight())
+        return -1;
+    return nokWidgetAdd(WIDGET_GAUGE, cx, cy, r, r + 1, vMin, vMax);
+}
+
+/************************************************************************************
+* Function: nokWidgetNumber
+* - adds a numeric field and draws 0. each digit is NOK_FONT_PITCH columns by 8 rows, at
+*   any y (a field off the bank grid costs two bytes per column)
+* argument:
+*   x, y - top left
+*   digits - 1 to WIDGET_DIGITS_MAX, a minus sign takes one
+* return: widget id, -1 if no slot is free or it does not fit the screen
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokWidgetNumber(unsigned char x, unsigned char y, unsigned char digits){
+    if (digits == 0 || digits > WIDGET_DIGITS_MAX || x + digits * NOK_FONT_PITCH > nokLcdWidth()
+            || y + LCD_ROW_IN_BANK > nokLcdHeight())
+        return -1;
+    return nokWidgetAdd(WIDGET_NUMBER, x, y, digits, LCD_ROW_IN_BANK, -32767, 32767);
+}
+
+/************************************************************************************
+* Function: nokWidgetSet
+* - gives a widget a new value and updates only what changed in the shadow RAM. call
+*   nokLcdFlush to send it. values outside vMin..vMax are clamped (not for WIDGET_NUMBER).
+* argument:
+*   id - widget id
+*   value - new value
+* return: 0 if valid, -1 if not
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokWidgetSet(unsigned char id, int value){
+    NOK_WIDGET* wg;
+
+    if (id >= WIDGET_MAX || widgets[id].type == WIDGET_NONE)
+        return -1;
+    wg = &widgets[id];
+    if (value < wg->vMin) value = wg->vMin;
+    if (value > wg->vMax) value = wg->vMax;
+    wg->value = value;
+    nokWidgetDraw(wg, 0);
+    return 0;
+}
+
+/************************************************************************************
+* Function: nokWidgetRemoveAll
+* - frees every widget slot. the pixels stay in the shadow RAM
+* argument: none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokWidgetRemoveAll(void){
+    unsigned char id;
+
+    for (id = 0; id < WIDGET_MAX; id++)
+        widgets[id].type = WIDGET_NONE;
+}
+
+/************************************************************************************
+* Function: nokWidgetDashboard
+* - clears the screen and lays out the sample dashboard for the current rotation:
+*   0 horizontal bar 0..100, 1 vertical bar 0..100, 2 gauge 0..100, 3 five digit number
+* argument: none
+* return: 0 if it fits, -1 if not
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokWidgetDashboard(void){
+    unsigned char w = nokLcdWidth() - 10;      // left of the vertical bar
+    unsigned char h = nokLcdHeight();
+    unsigned char r = (w / 2 - 1 < h - 18) ? w / 2 - 1 : h - 18;
+    int ok;
+
+    nokWidgetRemoveAll();
+    nokLcdClear();
+    ok = nokWidgetBar(0, 0, w, 6, 0, 100, 0) == 0;
+    ok &= nokWidgetBar(w + 2, 0, 8, h, 0, 100, 1) == 1;
+    ok &= nokWidgetGauge(w / 2, h - 1, r, 0, 100) == 2;
+    ok &= nokWidgetNumber(0, 8, 5) == 3;
+    nokLcdFlush();
+    return ok ? 0 : -1;
+}
+
+/************************************************************************************
+* Function: nokWidgetBench
+* - sets up the sample dashboard and moves each widget nUpdates times in small steps, one
+*   flush per update. reports per widget the LCD bus bytes per update against the bytes a
+*   full redraw of the widget would send, and the time per update, over UART A1
+* argument:
+*   nUpdates - updates per widget
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokWidgetBench(unsigned int nUpdates){
+    static const char* const names[] = {"hbar", "vbar", "gauge", "number"};
+    static const int steps[] = {1, 3, 2, 7};   // per update. small moves, as a dashboard sees
+    char line[80];
+    unsigned long bytes[4] = {0, 0, 0, 0};
+    unsigned long t0, us;
+    int v[4] = {0, 0, 0, 0};
+    int dv[4];
+    unsigned char defer;
+    unsigned int n;
+    unsigned char id;
+
+    if (nUpdates == 0 || nokWidgetDashboard() != 0)
+        return;
+
+    defer = nokLcdDeferFlush(0);               // measure real flushes even when run by the scheduler
+    memcpy(dv, steps, sizeof(dv));
+    t0 = timerB0Now();
+    for (n = 0; n < nUpdates; n++){
+        for (id = 0; id < 4; id++){
+            v[id] += dv[id];
+            if (id < 3 && (v[id] >= 100 || v[id] <= 0))
+                dv[id] = -dv[id];               // bars and gauge sweep back and forth
+            if (id == 3 && v[id] > 9999)
+                v[id] -= 10000;
+            nokWidgetSet(id, v[id]);
+            bytes[id] += nokLcdFlush();
+        }
+    }
+    us = timerB0TicksToUs(timerB0Now() - t0);
+    nokLcdDeferFlush(defer);
+
+    for (id = 0; id < 4; id++){
+        sprintf(line, "%-6s %lu.%lu bytes/update, full redraw %u\r\n", names[id], bytes[id] / nUpdates,
+                (bytes[id] * 10 / nUpdates) % 10, nokWidgetFullBytes(&widgets[id]));
+        usciA1UartTxString(line);
+    }
+    sprintf(line, "%u updates %lu us, %lu us per update\r\n", 4 * nUpdates, us, us / (4UL * nUpdates));
+    usciA1UartTxString(line);
+}
@@ -0,0 +1,142 @@
+/*************************************************************************************************
+ * nokWidget.h
+ * - C interface file for retained dashboard widgets on the NOKIA 5110 LCD.
+ *   A widget remembers what it last drew. A new value is turned into the columns that can
+ *   differ (the strip between the old and new bar ends, the columns both needles cross, the
+ *   digits that changed) and each bank byte there is rewritten as
+ *       (shadow & ~old pixels) | new pixels
+ *   nokLcdSetByte drops bytes that come out the same, so the flush carries the change and
+ *   not the widget. The widget owns its box: anything else drawn there is overwritten or
+ *   confuses the next update.
+ *   WIDGET_HBAR  : fills left to right, WIDGET_VBAR : fills bottom to top
+ *   WIDGET_GAUGE : half circle dial, needle from the centre. vMin points left, vMax right
+ *   WIDGET_NUMBER: right aligned decimal in fixed width 5x7 digits, '*' when it does not fit
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#ifndef NOKWIDGET_H_
+#define NOKWIDGET_H_
+
+#include "nok5110LCD.h"
+
+#define WIDGET_MAX          8
+#define WIDGET_DIGITS_MAX   6
+#define WIDGET_GAUGE_STEPS  64          // needle positions across the 180 degree dial
+#define WIDGET_GAUGE_R_MIN  4
+
+#define WIDGET_NONE         0
+#define WIDGET_HBAR         1
+#define WIDGET_VBAR         2
+#define WIDGET_GAUGE        3
+#define WIDGET_NUMBER       4
+
+typedef struct NOK_WIDGET {
+    unsigned char type;             // WIDGET_NONE when the slot is free
+    unsigned char x, y;             // top left. centre of the dial for WIDGET_GAUGE
+    unsigned char w, h;             // box. radius in w for WIDGET_GAUGE, digits in w for WIDGET_NUMBER
+    int vMin, vMax;
+    int value;
+    unsigned char fill;             // bar length in pixels on screen
+    unsigned char tipX, tipY;       // needle tip on screen
+    char text[WIDGET_DIGITS_MAX + 1];   // digits on screen
+}NOK_WIDGET;
+
+/************************************************************************************
+* Function: nokWidgetBar
+* - adds a bar and draws it empty (value vMin)
+* argument:
+*   x, y - top left
+*   w, h - size in pixels
+*   vMin, vMax - values for an empty and a full bar. vMax must be greater than vMin
+*   vertical - 1 fills bottom to top, 0 left to right
+* return: widget id, -1 if no slot is free, it does not fit the screen or vMax <= vMin
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokWidgetBar(unsigned char x, unsigned char y, unsigned char w, unsigned char h, int vMin, int vMax,
+                 unsigned char vertical);
+
+/************************************************************************************
+* Function: nokWidgetGauge
+* - adds a needle gauge and draws the dial with the needle at vMin. the needle is r - 2 long
+*   so it never touches the dial.
+* argument:
+*   cx, cy - centre of the dial. the dial spans cx - r .. cx + r and cy - r .. cy
+*   r - radius, at least WIDGET_GAUGE_R_MIN
+*   vMin, vMax - values at the left and right end. vMax must be greater than vMin
+* return: widget id, -1 if no slot is free, it does not fit the screen or vMax <= vMin
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokWidgetGauge(unsigned char cx, unsigned char cy, unsigned char r, int vMin, int vMax);
+
+/************************************************************************************
+* Function: nokWidgetNumber
+* - adds a numeric field and draws 0. each digit is NOK_FONT_PITCH columns by 8 rows, at
+*   any y (a field off the bank grid costs two bytes per column)
+* argument:
+*   x, y - top left
+*   digits - 1 to WIDGET_DIGITS_MAX, a minus sign takes one
+* return: widget id, -1 if no slot is free or it does not fit the screen
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokWidgetNumber(unsigned char x, unsigned char y, unsigned char digits);
+
+/************************************************************************************
+* Function: nokWidgetSet
+* - gives a widget a new value and updates only what changed in the shadow RAM. call
+*   nokLcdFlush to send it. values outside vMin..vMax are clamped (not for WIDGET_NUMBER).
+* argument:
+*   id - widget id
+*   value - new value
+* return: 0 if valid, -1 if not
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokWidgetSet(unsigned char id, int value);
+
+/************************************************************************************
+* Function: nokWidgetRemoveAll
+* - frees every widget slot. the pixels stay in the shadow RAM
+* argument: none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokWidgetRemoveAll(void);
+
+/************************************************************************************
+* Function: nokWidgetDashboard
+* - clears the screen and lays out the sample dashboard for the current rotation:
+*   0 horizontal bar 0..100, 1 vertical bar 0..100, 2 gauge 0..100, 3 five digit number
+* argument: none
+* return: 0 if it fits, -1 if not
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int nokWidgetDashboard(void);
+
+/************************************************************************************
+* Function: nokWidgetBench
+* - sets up the sample dashboard and moves each widget nUpdates times in small steps, one
+*   flush per update. reports per widget the LCD bus bytes per update against the bytes a
+*   full redraw of the widget would send, and the time per update, over UART A1
+* argument:
+*   nUpdates - updates per widget
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void nokWidgetBench(unsigned int nUpdates);
+
+#endif /* NOKWIDGET_H_ */
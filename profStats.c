@@ -0,0 +1,176 @@
+/*************************************************************************************************
+ * profStats.c
+ * - C implementation or source file for per-stage / per-command cycle profiling.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+#include <stdio.h>
+
+#include "profStats.h"
+#include "timerB0.h"
+#include "usciUart.h"
+
+#if PROF_ENABLE
+
+// fixed RAM for every slot. private to this file, reported through profStatsPrint
+static PROF_SLOT profSlots[PROF_NSLOTS];
+
+static const char* const profSlotNames[PROF_SLOT_CMD0] = {
+    "rx", "parse", "setPixel", "scrnLine", "drawLine", "clear", "flush"
+};
+
+/************************************************************************************
+* Function: profBucket
+* - log2 bucket of a duration. avoids a loop over all bits by halving the search.
+* arguments:
+*   ticks - duration in TB0 ticks
+* return: bucket index 0 .. PROF_NBUCKETS-1
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+*************************************************************************************/
+static unsigned int profBucket(unsigned long ticks){
+    unsigned int k = 0;
+
+    if (ticks >> 16) { ticks >>= 16; k += 16; }
+    if (ticks >> 8)  { ticks >>= 8;  k += 8; }
+    if (ticks >> 4)  { ticks >>= 4;  k += 4; }
+    if (ticks >> 2)  { ticks >>= 2;  k += 2; }
+    if (ticks >> 1)  { k += 1; }
+
+    return (k < PROF_NBUCKETS) ? k : PROF_NBUCKETS - 1;
+}
+
+/************************************************************************************
+* Function: profPercentile
+* - walks the histogram to find the bucket holding the requested percentile and returns
+*   the upper edge of that bucket (clipped to the observed max). the rank is taken from the
+*   histogram total, not count, since profStatsRecord halves the buckets when one fills up.
+* arguments:
+*   s   - slot to inspect
+*   pct - percentile 1 .. 100
+* return: percentile estimate in ticks
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+*************************************************************************************/
+static unsigned long profPercentile(const PROF_SLOT* s, unsigned int pct){
+    unsigned long total = 0, rank, seen = 0;
+    unsigned long edge;
+    unsigned int k;
+
+    for (k = 0; k < PROF_NBUCKETS; k++)
+        total += s->hist[k];
+    rank = (total * pct + 99) / 100;                    // ceil(total * pct / 100)
+    for (k = 0; k < PROF_NBUCKETS - 1; k++){
+        seen += s->hist[k];
+        if (seen >= rank)
+            break;
+    }
+    edge = (k < PROF_NBUCKETS - 1) ? ((2UL << k) - 1) : s->maxTicks;
+    return (edge < s->maxTicks) ? edge : s->maxTicks;
+}
+
+/************************************************************************************
+* Function: profStatsRecord
+* - accumulates one duration into a slot. called through PROF_STOP.
+* arguments:
+*   slot  - PROF_SLOT_xxx index
+*   ticks - measured duration in TB0 ticks
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+*************************************************************************************/
+void profStatsRecord(unsigned int slot, unsigned long ticks){
+    PROF_SLOT* s;
+    unsigned int k, i;
+
+    if (slot >= PROF_NSLOTS)
+        return;
+
+    s = &profSlots[slot];
+    if (s->count == 0 || ticks < s->minTicks)
+        s->minTicks = ticks;
+    if (ticks > s->maxTicks)
+        s->maxTicks = ticks;
+    s->count++;
+    s->sumTicks += ticks;
+
+    k = profBucket(ticks);
+    if (s->hist[k] == 0xFFFF){      // full: halve every bucket so the shape, and the percentiles, stay right
+        for (i = 0; i < PROF_NBUCKETS; i++)
+            s->hist[i] -= s->hist[i] / 2;  // rounds up, a bucket in use stays in use
+    }
+    s->hist[k]++;
+}
+
+/************************************************************************************
+* Function: profStatsReset
+* - clears every slot
+* arguments: none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+*************************************************************************************/
+void profStatsReset(void){
+    unsigned char* p = (unsigned char*)profSlots;
+    unsigned int i;
+
+    for (i = 0; i < sizeof(profSlots); i++)
+        p[i] = 0;
+}
+
+/************************************************************************************
+* Function: profStatsPrint
+* - prints count, min, mean, p50, p99 and max in microseconds for every slot that has
+*   samples, one line per slot, over UART A1
+* arguments:
+*   nok5110Cmds - command table, used to name the per command slots
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+*************************************************************************************/
+void profStatsPrint(CMD* nok5110Cmds){
+    char line[100];
+    const PROF_SLOT* s;
+    const char* name;
+    unsigned int i;
+
+    usciA1UartTxString("slot n min mean p50 p99 max (us)\r\n");
+    for (i = 0; i < PROF_NSLOTS; i++){
+        s = &profSlots[i];
+        if (s->count == 0)
+            continue;
+        name = (i < PROF_SLOT_CMD0) ? profSlotNames[i] : nok5110Cmds[i - PROF_SLOT_CMD0].name;
+        sprintf(line, "%s %lu %lu %lu %lu %lu %lu\r\n", name, s->count,
+                timerB0TicksToUs(s->minTicks),
+                timerB0TicksToUs((unsigned long)(s->sumTicks / s->count)),
+                timerB0TicksToUs(profPercentile(s, 50)),
+                timerB0TicksToUs(profPercentile(s, 99)),
+                timerB0TicksToUs(s->maxTicks));
+        usciA1UartTxString(line);
+    }
+}
+
+#else
+
+void profStatsRecord(unsigned int slot, unsigned long ticks){
+    (void)slot;
+    (void)ticks;
+}
+
+void profStatsReset(void){
+}
+
+void profStatsPrint(CMD* nok5110Cmds){
+    (void)nok5110Cmds;
+    usciA1UartTxString("Profiling disabled. Build with PROF_ENABLE = 1.\r\n");
+}
+
+#endif /* PROF_ENABLE */
@@ -0,0 +1,57 @@
+/*************************************************************************************************
+ * profStats.h
+ * - C interface file for per-stage / per-command cycle profiling.
+ *   Durations are measured with timerB0 and accumulated per slot as count, min, max, mean
+ *   and a log2 histogram so p50/p99 can be reported by the stats command.
+ *   Build with PROF_ENABLE = 1 to compile the instrumentation in. With PROF_ENABLE = 0 the
+ *   PROF_START/PROF_STOP macros expand to nothing.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#ifndef PROFSTATS_H_
+#define PROFSTATS_H_
+
+#include "cmdNok5110LCD.h"
+
+#ifndef PROF_ENABLE
+#define PROF_ENABLE         0       // set to 1 here or in the project predefined symbols
+#endif
+
+// profiling slots. main loop stages, drawing primitives, then one slot per command index
+#define PROF_SLOT_RX        0       // usciA1UartGets
+#define PROF_SLOT_PARSE     1       // parseCmd
+#define PROF_SLOT_SETPIXEL  2       // nokLcdSetPixel
+#define PROF_SLOT_SCRNLINE  3       // nokLcdDrawScrnLine
+#define PROF_SLOT_DRAWLINE  4       // nokLcdDrawLine
+#define PROF_SLOT_CLEAR     5       // nokLcdClear
+#define PROF_SLOT_FLUSH     6       // nokLcdFlush (includes the rotation transform)
+#define PROF_SLOT_CMD0      7       // executeCMD for command index 0. index n uses PROF_SLOT_CMD0 + n
+#define PROF_NSLOTS         (PROF_SLOT_CMD0 + MAX_CMDS)
+
+#define PROF_NBUCKETS       20      // bucket k holds durations in [2^k, 2^(k+1)) ticks. last bucket is open ended
+
+#if PROF_ENABLE
+#define PROF_START(t)       unsigned long t = timerB0Now()
+#define PROF_STOP(slot, t)  profStatsRecord((slot), timerB0Now() - (t))
+#else
+#define PROF_START(t)                                   // a declaration, so nothing at all
+#define PROF_STOP(slot, t)  do {} while (0)
+#endif
+
+typedef struct PROF_SLOT {
+    unsigned long count;                // number of samples
+    unsigned long minTicks;
+    unsigned long maxTicks;
+    unsigned long long sumTicks;        // for the mean
+    unsigned int hist[PROF_NBUCKETS];   // log2 histogram. halved when a bucket fills up
+}PROF_SLOT;
+
+//-------------- func prototypes-------------
+
+void profStatsRecord(unsigned int slot, unsigned long ticks);
+void profStatsReset(void);
+void profStatsPrint(CMD* nok5110Cmds);
+
+#endif /* PROFSTATS_H_ */
@@ -0,0 +1,191 @@
+/*************************************************************************************************
+ * sched.c
+ * - C implementation or source file for the run to completion scheduler that pipelines the
+ *   command stages.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "sched.h"
+#include "nok5110LCD.h"
+#include "events.h"
+#include "timerB0.h"
+#include "profStats.h"
+#include "cmdCapture.h"
+
+static CMD* schedCmds;
+
+// command queue between parse and render. free running indexes
+static SCHED_CMD schedQ[SCHED_CMD_Q];
+static unsigned char schedHead = 0;
+static unsigned char schedTail = 0;
+
+static char schedLine[BUFF_SZ];             // line being parsed
+static char schedRaw[BUFF_SZ];              // copy of the line before parseCmd splits it, for capture
+static unsigned char schedUnflushed = 0;    // renders since the last flush
+
+// counters for schedReport
+static unsigned long schedParsed = 0;
+static unsigned long schedInvalid = 0;
+static unsigned long schedRendered = 0;
+static unsigned long schedFlushes = 0;
+static unsigned long schedForced = 0;
+static unsigned long schedFlushBytes = 0;
+static unsigned long schedStalls = 0;       // steps where a line waited on a full command queue
+static unsigned char schedQHigh = 0;
+static unsigned char schedLineHigh = 0;
+
+//-- parse stage. one line into one command record
+static void schedParse(void){
+    SCHED_CMD* rec;
+    int cmdIndex;
+    PROF_START(tRx);
+
+    usciA1UartLineGet(schedLine);
+    PROF_STOP(PROF_SLOT_RX, tRx);
+    if (cmdCaptureActive())
+        strcpy(schedRaw, schedLine);
+
+    PROF_START(tParse);
+    cmdIndex = parseCmd(schedCmds, schedLine);
+    PROF_STOP(PROF_SLOT_PARSE, tParse);
+    if (cmdIndex == -1){
+        schedInvalid++;
+        usciA1UartTxString("Invalid command.");
+        return;
+    }
+    if (cmdCaptureActive())
+        cmdCaptureLine(cmdIndex, schedRaw);
+
+    // args and text live in the command table and the line buffer, both reused by the next parse
+    rec = &schedQ[schedHead & SCHED_CMD_Q_MASK];
+    rec->idx = cmdIndex;
+    memcpy(rec->args, schedCmds[cmdIndex].args, sizeof(rec->args));
+    rec->text[0] = NULL_CHAR;
+    if (schedCmds[cmdIndex].text)
+        strcpy(rec->text, schedCmds[cmdIndex].text);
+    schedCmds[cmdIndex].text = 0;               // only commands that take text set it again
+    schedHead++;
+    schedParsed++;
+    if ((unsigned char)(schedHead - schedTail) > schedQHigh)
+        schedQHigh = schedHead - schedTail;
+}
+
+//-- flush stage. everything rendered since the last flush in one burst
+static void schedFlush(void){
+    nokLcdDeferFlush(0);
+    schedFlushBytes += nokLcdFlush();
+    nokLcdDeferFlush(1);
+    schedFlushes++;
+    schedUnflushed = 0;
+}
+
+//-- render stage. runs the oldest command record
+static int schedRender(void){
+    SCHED_CMD* rec = &schedQ[schedTail & SCHED_CMD_Q_MASK];
+    int cmdIndex = rec->idx;
+    unsigned long t0 = timerB0Now();
+
+    memcpy(schedCmds[cmdIndex].args, rec->args, sizeof(rec->args));
+    schedCmds[cmdIndex].text = rec->text;
+
+    PROF_START(tExec);
+    executeCMD(schedCmds, cmdIndex);
+    PROF_STOP(PROF_SLOT_CMD0 + cmdIndex, tExec);
+    schedCmds[cmdIndex].text = 0;
+    schedTail++;                                // record free for the next parse
+    schedRendered++;
+
+    if (++schedUnflushed >= SCHED_FLUSH_MAX){   // steady stream. do not starve the panel
+        schedForced++;
+        schedFlush();
+    }
+    eventAccountCmd(cmdIndex, timerB0Now() - t0);
+    return cmdIndex;
+}
+
+/************************************************************************************
+* Function: schedInit
+* - empties the command queue, clears the counters and defers LCD flushes to the flush stage
+* arguments:
+*   nok5110Cmds - command table used by parse and render
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void schedInit(CMD* nok5110Cmds){
+    schedCmds = nok5110Cmds;
+    schedHead = schedTail = 0;
+    schedUnflushed = 0;
+    schedParsed = schedInvalid = schedRendered = 0;
+    schedFlushes = schedForced = schedFlushBytes = schedStalls = 0;
+    schedQHigh = schedLineHigh = 0;
+    nokLcdDeferFlush(1);
+}
+
+/************************************************************************************
+* Function: schedStep
+* - runs the first ready stage in the order parse, render, flush. sleeps in LPM0 until the
+*   next line if none is ready.
+* arguments: none
+* return: index of the command rendered, -1 if this step did not render one
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int schedStep(void){
+    unsigned int lines = usciA1UartLinesPending();
+    unsigned char queued = schedHead - schedTail;
+
+    if (lines > schedLineHigh)
+        schedLineHigh = lines;
+
+    // parse first so a burst of lines is rendered before the one flush that covers it
+    if (lines && queued < SCHED_CMD_Q){
+        schedParse();
+        return -1;
+    }
+    if (lines)
+        schedStalls++;                          // back-pressure. the line stays in the UART queue
+    if (queued)
+        return schedRender();
+    if (schedUnflushed){
+        schedFlush();
+        return -1;
+    }
+
+    eventWait(EVT_UART_LINE);                   // nothing ready. LPM0 until the RX ISR has a line
+    return -1;
+}
+
+/************************************************************************************
+* Function: schedReport
+* - prints per stage run counts, queue high water marks, back-pressure and overrun counts,
+*   and commands rendered per flush over UART A1
+* arguments: none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void schedReport(void){
+    char line[80];
+
+    sprintf(line, "parsed %lu invalid %lu rendered %lu\r\n", schedParsed, schedInvalid, schedRendered);
+    usciA1UartTxString(line);
+    sprintf(line, "flushes %lu (forced %lu) %lu bytes, %lu.%02lu cmds/flush\r\n", schedFlushes, schedForced,
+            schedFlushBytes, schedFlushes ? schedRendered / schedFlushes : 0,
+            schedFlushes ? (schedRendered * 100 / schedFlushes) % 100 : 0);
+    usciA1UartTxString(line);
+    sprintf(line, "high water: lines %u/%u cmds %u/%u\r\n", schedLineHigh, UART_RX_LINES,
+            schedQHigh, SCHED_CMD_Q);
+    usciA1UartTxString(line);
+    sprintf(line, "back-pressure stalls %lu, rx chars dropped %u\r\n", schedStalls, usciA1UartRxDropped());
+    usciA1UartTxString(line);
+}
@@ -0,0 +1,70 @@
+/*************************************************************************************************
+ * sched.h
+ * - C interface file for the run to completion scheduler that pipelines the command stages.
+ *   receive : the USCI_A1 RX ISR assembles lines into the UART line queue (UART_RX_LINES)
+ *   parse   : takes a line and turns it into a SCHED_CMD record in the command queue
+ *   render  : runs the oldest record. drawing only reaches the shadow RAM (deferred flush)
+ *   flush   : sends everything dirty in one burst once both queues are empty, or after
+ *             SCHED_FLUSH_MAX renders so a steady stream still updates the panel
+ *   Back-pressure: parse waits while the command queue is full, which leaves lines in the
+ *   UART queue. when that fills too the RX ISR drops characters and counts them.
+ *   No register access here, so the queue and stage logic builds on a PC against stubs.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#ifndef SCHED_H_
+#define SCHED_H_
+
+#include "cmdNok5110LCD.h"
+#include "usciUart.h"
+
+#define SCHED_CMD_Q         4       // parsed commands waiting to render. must be a power of 2
+#define SCHED_CMD_Q_MASK    (SCHED_CMD_Q - 1)
+#define SCHED_FLUSH_MAX     8       // renders allowed before a flush is forced
+
+// one parsed command. text holds the rest of the line for commands like print
+typedef struct SCHED_CMD {
+    int idx;
+    int args[MAX_ARGS];
+    char text[BUFF_SZ];
+}SCHED_CMD;
+
+/************************************************************************************
+* Function: schedInit
+* - empties the command queue, clears the counters and defers LCD flushes to the flush stage
+* arguments:
+*   nok5110Cmds - command table used by parse and render
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void schedInit(CMD* nok5110Cmds);
+
+/************************************************************************************
+* Function: schedStep
+* - runs the first ready stage in the order parse, render, flush. sleeps in LPM0 until the
+*   next line if none is ready.
+* arguments: none
+* return: index of the command rendered, -1 if this step did not render one
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int schedStep(void);
+
+/************************************************************************************
+* Function: schedReport
+* - prints per stage run counts, queue high water marks, back-pressure and overrun counts,
+*   and commands rendered per flush over UART A1
+* arguments: none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void schedReport(void);
+
+#endif /* SCHED_H_ */
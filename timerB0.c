@@ -0,0 +1,164 @@
+/*************************************************************************************************
+ * timerB0.c
+ * - C implementation or source file for the free-running Timer_B0 timestamp counter.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+#include "timerB0.h"
+#include "events.h"
+
+// upper 16 bits of the timestamp. incremented by the TB0 overflow (TBIFG) interrupt
+static volatile unsigned int tb0Overflows = 0;
+
+static unsigned int tb0TickPeriod = 0;         // CCR0 increment per tick. 0 - tick stopped
+
+/************************************************************************************
+* Function: timerB0Init
+* - starts TB0 in continuous mode from SMCLK / 8 with the overflow interrupt enabled.
+*   GIE must be set by the caller for the overflow count to advance.
+* argument:
+*   none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void timerB0Init(void){
+    tb0Overflows = 0;
+    TB0CTL = TBSSEL__SMCLK      // SMCLK source
+           + ID__8              // /8 so a 16 bit CCR0 period still reaches a 100 Hz tick at 25 MHz
+           + MC__CONTINUOUS     // count 0 -> 0xFFFF and roll over
+           + TBCLR              // start from 0
+           + TBIE;              // interrupt on roll over
+}
+
+/************************************************************************************
+* Function: timerB0Now
+* - returns the current 32 bit timestamp in TB0 ticks. Safe to call with interrupts
+*   enabled or disabled (a pending overflow is accounted for).
+* argument:
+*   none
+* return: tick count since timerB0Init
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned long timerB0Now(void){
+    unsigned int sr = __get_SR_register();
+    unsigned int hi, lo;
+
+    __disable_interrupt();
+    lo = TB0R;
+    hi = tb0Overflows;
+    if ((TB0CTL & TBIFG) && lo < 0x8000)    // rolled over but the ISR has not run yet
+        hi++;
+    __bis_SR_register(sr & GIE);            // restore GIE only if it was set on entry
+
+    return ((unsigned long)hi << 16) | lo;
+}
+
+/************************************************************************************
+* Function: timerB0TicksToUs
+* - converts a tick count (or difference of two timestamps) to microseconds
+* argument:
+*   ticks - number of TB0 ticks
+* return: microseconds
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned long timerB0TicksToUs(unsigned long ticks){
+    return (unsigned long)(((unsigned long long)ticks * 1000000UL) / TIMERB0_CLK_HZ);
+}
+
+/************************************************************************************
+* Function: timerB0TickStart
+* - starts the periodic tick on CCR0. every period the ISR posts EVT_TICK and wakes the
+*   main loop. tickHz below TIMERB0_CLK_HZ / 65536 is clamped to the longest period.
+* argument:
+*   tickHz - tick rate in Hz
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void timerB0TickStart(unsigned int tickHz){
+    unsigned long period = TIMERB0_CLK_HZ / (tickHz ? tickHz : 1);
+
+    tb0TickPeriod = (period > 0xFFFF) ? 0xFFFF : (unsigned int)period;
+    TB0CCR0 = TB0R + tb0TickPeriod;
+    TB0CCTL0 = CCIE;            // compare mode, interrupt on match
+}
+
+/************************************************************************************
+* Function: timerB0TickStop
+* - stops the periodic tick so the CPU is not woken for nothing
+* argument:
+*   none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void timerB0TickStop(void){
+    TB0CCTL0 = 0;
+    tb0TickPeriod = 0;
+}
+
+/************************************************************************************
+* Function: timerB0AlarmIn
+* - one-shot alarm on CCR1. posts EVT_ALARM once, ticks from now, and is then disarmed.
+*   independent of the CCR0 tick, so it can be used while other code starts and stops
+*   the tick. arming again replaces a pending alarm.
+* argument:
+*   ticks - TB0 ticks from now, at least TIMERB0_ALARM_MIN
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void timerB0AlarmIn(unsigned int ticks){
+    TB0CCTL1 = 0;                           // disarm and clear CCIFG before moving the compare
+    TB0CCR1 = TB0R + ticks;
+    eventFlags &= ~EVT_ALARM;
+    TB0CCTL1 = CCIE;
+}
+
+/************************************************************************************
+* Function: timerB0AlarmStop
+* - disarms the CCR1 alarm and drops an EVT_ALARM it already posted
+* argument:
+*   none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void timerB0AlarmStop(void){
+    TB0CCTL1 = 0;
+    eventFlags &= ~EVT_ALARM;
+}
+
+#pragma vector = TIMER0_B0_VECTOR
+__interrupt void timerB0TickIsr(void) {
+    TB0CCR0 += tb0TickPeriod;               // next tick. CCIFG is cleared automatically for CCR0
+    EVENT_POST_FROM_ISR(EVT_TICK);
+}
+
+#pragma vector = TIMER0_B1_VECTOR
+__interrupt void timerB0Isr(void) {
+    switch(__even_in_range(TB0IV, 14))  // reading TB0IV clears the highest pending flag
+    {
+    case 2:                             // CCR1 - one-shot alarm
+        TB0CCTL1 = 0;
+        EVENT_POST_FROM_ISR(EVT_ALARM);
+        break;
+    case 14:                            // TBIFG - counter rolled over
+        tb0Overflows++;
+        break;
+    default: break;
+    }
+}
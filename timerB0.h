@@ -0,0 +1,110 @@
+/*************************************************************************************************
+ * timerB0.h
+ * - C interface file for the free-running Timer_B0 timestamp counter on the MSP430F5529.
+ *   TB0 runs in continuous mode from SMCLK / 8 and its overflows are counted in software so
+ *   timerB0Now() returns a 32 bit tick count. CCR0 optionally posts a periodic EVT_TICK,
+ *   CCR1 a one-shot EVT_ALARM.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#ifndef TIMERB0_H_
+#define TIMERB0_H_
+
+#include "ucsClock.h"
+
+#define TIMERB0_DIV     8                                   // TB0 input divider (ID__8)
+#define TIMERB0_CLK_HZ  (ucsClockSmclkHz() / TIMERB0_DIV)   // TB0 is clocked by SMCLK / 8
+#define TIMERB0_ALARM_MIN   16      // shortest alarm. CCR1 must not be passed before it is armed
+
+/************************************************************************************
+* Function: timerB0Init
+* - starts TB0 in continuous mode from SMCLK / 8 with the overflow interrupt enabled.
+*   GIE must be set by the caller for the overflow count to advance.
+* argument:
+*   none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void timerB0Init(void);
+
+/************************************************************************************
+* Function: timerB0Now
+* - returns the current 32 bit timestamp in TB0 ticks. Safe to call with interrupts
+*   enabled or disabled (a pending overflow is accounted for).
+* argument:
+*   none
+* return: tick count since timerB0Init
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned long timerB0Now(void);
+
+/************************************************************************************
+* Function: timerB0TicksToUs
+* - converts a tick count (or difference of two timestamps) to microseconds
+* argument:
+*   ticks - number of TB0 ticks
+* return: microseconds
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned long timerB0TicksToUs(unsigned long ticks);
+
+/************************************************************************************
+* Function: timerB0TickStart
+* - starts the periodic tick on CCR0. every period the ISR posts EVT_TICK and wakes the
+*   main loop. tickHz below TIMERB0_CLK_HZ / 65536 is clamped to the longest period.
+* argument:
+*   tickHz - tick rate in Hz
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void timerB0TickStart(unsigned int tickHz);
+
+/************************************************************************************
+* Function: timerB0TickStop
+* - stops the periodic tick so the CPU is not woken for nothing
+* argument:
+*   none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void timerB0TickStop(void);
+
+/************************************************************************************
+* Function: timerB0AlarmIn
+* - one-shot alarm on CCR1. posts EVT_ALARM once, ticks from now, and is then disarmed.
+*   independent of the CCR0 tick, so it can be used while other code starts and stops
+*   the tick. arming again replaces a pending alarm.
+* argument:
+*   ticks - TB0 ticks from now, at least TIMERB0_ALARM_MIN
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void timerB0AlarmIn(unsigned int ticks);
+
+/************************************************************************************
+* Function: timerB0AlarmStop
+* - disarms the CCR1 alarm and drops an EVT_ALARM it already posted
+* argument:
+*   none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void timerB0AlarmStop(void);
+
+#endif /* TIMERB0_H_ */
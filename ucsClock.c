@@ -0,0 +1,201 @@
+/*************************************************************************************************
+ * ucsClock.c
+ * - C implementation or source file for the UCS clock system on the MSP430F5529.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#include <msp430.h>
+#include <stdio.h>
+
+#include "ucsClock.h"
+#include "usciUart.h"
+#include "usciSpi.h"
+
+static unsigned long ucsSmclkHz = UCS_RESET_SMCLK_HZ;
+
+// F5529 datasheet: slowest fDCO at DCOx = 31 in each DCORSEL range, the most the range is sure to reach
+static const unsigned long ucsDcoRangeMaxHz[] = {700000UL, 1470000UL, 3170000UL, 6070000UL, 12300000UL,
+                                                 23700000UL, 39000000UL, 60000000UL};
+
+// rates listed by ucsClockReport
+static const unsigned long ucsBaudRates[] = {9600, 19200, 38400, 57600, 115200, 230400, 460800};
+
+/************************************************************************************
+* Function: ucsSetVCoreUp
+* - raises the core voltage by one level. the SVS/SVM high and low side are moved to the
+*   new level first and the core is only switched once the SVM reports it is safe.
+*   Sequence from the F5xx family user guide, PMM chapter.
+* argument:
+*   level - new PMMCOREV level 1..3. must be exactly one above the current level
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+static void ucsSetVCoreUp(unsigned int level){
+    PMMCTL0_H = PMMPW_H;                                            // open PMM registers for write
+    SVSMHCTL = SVSHE + SVSHRVL0 * level + SVMHE + SVSMHRRL0 * level; // high side SVS/SVM to new level
+    SVSMLCTL = SVSLE + SVMLE + SVSMLRRL0 * level;                   // low side SVM to new level
+    while ((PMMIFG & SVSMLDLYIFG) == 0);                            // wait till SVM settles
+    PMMIFG &= ~(SVMLVLRIFG + SVMLIFG);
+    PMMCTL0_L = PMMCOREV0 * level;                                  // set Vcore
+    if ((PMMIFG & SVMLIFG))
+        while ((PMMIFG & SVMLVLRIFG) == 0);                         // wait till the new level is reached
+    SVSMLCTL = SVSLE + SVSLRVL0 * level + SVMLE + SVSMLRRL0 * level; // low side SVS to new level
+    PMMCTL0_H = 0x00;                                               // lock PMM registers
+}
+
+/************************************************************************************
+* Function: ucsClockInit
+* - sets MCLK = SMCLK to mclkHz (rounded down to a multiple of 32768 Hz, at most UCS_MAX_HZ)
+*   with the FLL referenced to REFO. Vcore is stepped up to the level the frequency needs first.
+*   Peripherals that divide SMCLK must be reconfigured afterwards.
+* argument:
+*   mclkHz - requested MCLK/SMCLK frequency in Hz
+* return: actual SMCLK frequency in Hz
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned long ucsClockInit(unsigned long mclkHz){
+    unsigned int fllN;          // DCOCLKDIV = (N + 1) x REFO
+    unsigned int level;         // Vcore level required for mclkHz
+    unsigned int range;         // DCORSEL range that holds the DCO
+    unsigned int i;
+
+    if (mclkHz > UCS_MAX_HZ)
+        mclkHz = UCS_MAX_HZ;
+    if (mclkHz < UCS_REFO_HZ * 2)
+        mclkHz = UCS_REFO_HZ * 2;
+    fllN = (unsigned int)(mclkHz / UCS_REFO_HZ) - 1;
+
+    // F5529 datasheet: PMMCOREV_0 <= 8 MHz, _1 <= 12 MHz, _2 <= 20 MHz, _3 <= 25 MHz
+    if (mclkHz <= 8000000UL) level = 0;
+    else if (mclkHz <= 12000000UL) level = 1;
+    else if (mclkHz <= 20000000UL) level = 2;
+    else level = 3;
+
+    for (i = (PMMCTL0 & PMMCOREV_3) + 1; i <= level; i++)     // one level at a time, never down
+        ucsSetVCoreUp(i);
+
+    UCSCTL3 = SELREF__REFOCLK;                  // FLL reference = REFO
+    UCSCTL4 = SELA__REFOCLK + SELS__DCOCLKDIV + SELM__DCOCLKDIV;
+
+    __bis_SR_register(SCG0);                    // disable the FLL while it is reprogrammed
+    UCSCTL0 = 0x0000;                           // lowest DCOx, MODx. the FLL will walk up
+    // DCO runs at 2 x DCOCLKDIV (FLLD_1). lowest range every part reaches that in: 25 MHz needs DCORSEL_7
+    for (range = 0; range < 7 && 2 * mclkHz > ucsDcoRangeMaxHz[range]; range++);
+    UCSCTL1 = DCORSEL0 * range;
+    UCSCTL2 = FLLD_1 + fllN;
+    __bic_SR_register(SCG0);                    // enable the FLL
+
+    // worst case settling is 32 x 32 reference periods per DCO tap: 1024 x (N + 1) MCLK cycles
+    for (i = 0; i <= fllN; i++)
+        __delay_cycles(1024);
+
+    do {                                        // wait for the DCO fault flag to stay clear
+        UCSCTL7 &= ~(XT2OFFG + XT1LFOFFG + DCOFFG);
+        SFRIFG1 &= ~OFIFG;
+    } while (SFRIFG1 & OFIFG);
+
+    ucsSmclkHz = (unsigned long)(fllN + 1) * UCS_REFO_HZ;
+    return ucsSmclkHz;
+}
+
+/************************************************************************************
+* Function: ucsClockSmclkHz
+* - current SMCLK frequency. UCS_RESET_SMCLK_HZ until ucsClockInit is called.
+* argument:
+*   none
+* return: SMCLK in Hz
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned long ucsClockSmclkHz(void){
+    return ucsSmclkHz;
+}
+
+/************************************************************************************
+* Function: ucsBaudCalc
+* - computes UCAxBRx/UCAxMCTL settings for a baud rate per the family user guide
+*   (oversampling when N = clkHz / baud >= 16, low frequency mode otherwise) and the
+*   resulting average baud error. Pure arithmetic, touches no registers.
+* argument:
+*   clkHz - BRCLK frequency in Hz
+*   baud  - requested baud rate
+*   cfg   - filled with the register values and error
+* return: 0 if the rate is reachable, -1 if not (N < 1 or UCBRx overflows)
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int ucsBaudCalc(unsigned long clkHz, unsigned long baud, UART_BAUD_CFG* cfg){
+    unsigned long n16;          // N in 1/16ths (oversampling) or 1/8ths (low frequency), rounded
+    unsigned long clk;          // BRCLK in the same units as n16: Hz, or Hz x 8 in low frequency mode
+    long diff;
+
+    if (baud == 0 || clkHz < baud)
+        return -1;
+
+    if (clkHz / baud >= 16){
+        // UCBRx = INT(N / 16), UCBRFx = round(frac(N / 16) x 16) -> bit time is round(N) BRCLKs
+        n16 = (clkHz + baud / 2) / baud;
+        if ((n16 >> 4) > 0xFFFF)
+            return -1;
+        cfg->os16 = 1;
+        cfg->br = (unsigned int)(n16 >> 4);
+        cfg->brf = (unsigned char)(n16 & 0x0F);
+        cfg->brs = 0;
+        clk = clkHz;
+    }
+    else {
+        // UCBRx = INT(N), UCBRSx = round(frac(N) x 8) -> average bit time is N8 / 8 BRCLKs
+        n16 = (clkHz * 8 + baud / 2) / baud;
+        cfg->os16 = 0;
+        cfg->br = (unsigned int)(n16 >> 3);
+        cfg->brs = (unsigned char)(n16 & 0x07);
+        cfg->brf = 0;
+        clk = clkHz * 8;
+    }
+
+    // error = clk / (n16 x baud) - 1, without truncating the effective baud to whole Hz first.
+    // n16 is rounded so |diff| <= baud / 2 and diff x 1000 stays inside a long
+    diff = (long)clk - (long)(n16 * baud);
+    cfg->errBp = (int)(diff * 1000L / (long)(n16 * baud / 10));
+    return 0;
+}
+
+/************************************************************************************
+* Function: ucsClockReport
+* - prints SMCLK and the UART settings/error for the common baud rates over UART A1
+* argument:
+*   none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void ucsClockReport(void){
+    char line[64];
+    UART_BAUD_CFG cfg;
+    unsigned int i;
+    int err;
+
+    sprintf(line, "SMCLK %lu Hz SCLK %lu Hz\r\n", ucsSmclkHz, usciB1SpiSclkHz());
+    usciA1UartTxString(line);
+    usciA1UartTxString("baud br brs brf os16 err%\r\n");
+    for (i = 0; i < sizeof(ucsBaudRates) / sizeof(ucsBaudRates[0]); i++){
+        if (ucsBaudCalc(ucsSmclkHz, ucsBaudRates[i], &cfg)){
+            sprintf(line, "%lu unreachable\r\n", ucsBaudRates[i]);
+        }
+        else {
+            err = (cfg.errBp < 0) ? -cfg.errBp : cfg.errBp;
+            sprintf(line, "%lu %u %u %u %u %c%d.%02d\r\n", ucsBaudRates[i], cfg.br, cfg.brs,
+                    cfg.brf, cfg.os16, (cfg.errBp < 0) ? '-' : '+', err / 100, err % 100);
+        }
+        usciA1UartTxString(line);
+    }
+}
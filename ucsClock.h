@@ -0,0 +1,82 @@
+/*************************************************************************************************
+ * ucsClock.h
+ * - C interface file for the UCS clock system on the MSP430F5529.
+ *   Runs MCLK = SMCLK = DCOCLKDIV from the FLL locked to REFO (32768 Hz), raising Vcore one
+ *   level at a time before the frequency goes up. Also holds the UART/SPI divider calculator
+ *   so the peripherals can be reconfigured for whatever SMCLK ends up being.
+ *
+ *  Author: Marcus Kuhn
+ *  Created on: Oct 19th, 2026
+ **************************************************************************************************/
+
+#ifndef UCSCLOCK_H_
+#define UCSCLOCK_H_
+
+#define UCS_REFO_HZ         32768UL         // FLL reference
+#define UCS_RESET_SMCLK_HZ  1048576UL       // UCS default after reset: DCOCLKDIV = 32 x 32768
+#define UCS_MCLK_HZ         16000000UL      // requested MCLK = SMCLK. rounded down to a multiple of 32768 Hz
+#define UCS_MAX_HZ          25000000UL      // F5529 maximum at PMMCOREV_3
+
+typedef struct UART_BAUD_CFG {
+    unsigned int br;        // UCBRx (UCAxBR0 + UCAxBR1 << 8)
+    unsigned char brs;      // UCBRSx second stage modulation
+    unsigned char brf;      // UCBRFx first stage modulation (oversampling only)
+    unsigned char os16;     // 1 - UCOS16 oversampling mode
+    int errBp;              // baud error in 0.01 % (basis points). + means faster than requested
+}UART_BAUD_CFG;
+
+/************************************************************************************
+* Function: ucsClockInit
+* - sets MCLK = SMCLK to mclkHz (rounded down to a multiple of 32768 Hz, at most UCS_MAX_HZ)
+*   with the FLL referenced to REFO. Vcore is stepped up to the level the frequency needs first.
+*   Peripherals that divide SMCLK must be reconfigured afterwards.
+* argument:
+*   mclkHz - requested MCLK/SMCLK frequency in Hz
+* return: actual SMCLK frequency in Hz
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned long ucsClockInit(unsigned long mclkHz);
+
+/************************************************************************************
+* Function: ucsClockSmclkHz
+* - current SMCLK frequency. UCS_RESET_SMCLK_HZ until ucsClockInit is called.
+* argument:
+*   none
+* return: SMCLK in Hz
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned long ucsClockSmclkHz(void);
+
+/************************************************************************************
+* Function: ucsBaudCalc
+* - computes UCAxBRx/UCAxMCTL settings for a baud rate per the family user guide
+*   (oversampling when N = clkHz / baud >= 16, low frequency mode otherwise) and the
+*   resulting average baud error. Pure arithmetic, touches no registers.
+* argument:
+*   clkHz - BRCLK frequency in Hz
+*   baud  - requested baud rate
+*   cfg   - filled with the register values and error
+* return: 0 if the rate is reachable, -1 if not (N < 1 or UCBRx overflows)
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int ucsBaudCalc(unsigned long clkHz, unsigned long baud, UART_BAUD_CFG* cfg);
+
+/************************************************************************************
+* Function: ucsClockReport
+* - prints SMCLK and the UART settings/error for the common baud rates over UART A1
+* argument:
+*   none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void ucsClockReport(void);
+
+#endif /* UCSCLOCK_H_ */
@@ -1,112 +1,338 @@
-/*
- * usciSpi.c
- *
- * create a proper file header for the C module
- */
-
-#include <msp430.h>
-#include <stdio.h>
-#include <stdlib.h>
-
-#include "usciSpi.h"
-#include "usciUart.h"
-
-
-// create a function header that describes the function and how to use it. Provide an example function call.
-void usciB1SpiInit(unsigned char spiMST, unsigned int sclkDiv, unsigned char sclkMode, unsigned char spiLoopBack){
-	
-	// call usciB1SpiClkDiv
-	usciB1SpiClkDiv(sclkDiv);
-
-    UCB1CTL1 |= UCSWRST;                        // **Put state machine in USCI reset while you intitialize it**
-
-	// configure the control registers using the input arguments. See user manual, lecture notes and programmers model
-	UCB1CTL0 |= (sclkMode << 6)      // set clock mode sclkMode.1 = UCCKPH, sclkMode.0 = UCCKPL
-	         + (spiMST << 3)        // 0 = slave, 1 = master
-	         + UCMSB
-	         + UCSYNC;              // Sync == 1, SPI mode
-
-	UCB1CTL1 |= UCSSEL__SMCLK;
-	
-	if(spiLoopBack)
-	    UCB1STAT = UCLISTEN;
-
-	// configure the SPI B1 pins with PxSEL register
-	P4SEL |= SIMO_B1 + SCLK_B1;
-
-	// configure P6.0 to be output (SS)
-	P6DIR |= SS_B1;     // set P6.0 as output
-	P6OUT |= SS_B1;     // set it high (de-asserted)
-
-	UCB1CTL1 &= ~UCSWRST;                     	// **Initialize USCI state machine**  take it out of reset
-}
-
-
-// provide function header
-// this function is complete. Understand what it is doing.  Call it when SCLKDIV needs to be changed in Lab.
-void usciB1SpiClkDiv(unsigned int sclkDiv){
-
-    UCB1CTL1 |= UCSWRST;                        // you always need to put state machine into reset when configuring USC module
-
-    UCB1BR0 = (sclkDiv&0xFF);                   // 2
-    UCB1BR1 = (sclkDiv>>8);                     //
-
-    UCB1CTL1 &= ~UCSWRST;                       // **Initialize USCI state machine**
-}
-
-
-// when the TXBUFFER is ready load it.    txByte-->TXBUFFER
-// provide a function header
-void usciB1SpiPutChar(char txByte) {
-    while (!(UCB1IFG & UCTXIFG)); // is this efficient ?
-        UCB1TXBUF = txByte;  // if TXBUFF ready then transmit a byte by writing to it
-}
-
-int usciB1SpiTxBuffer(int* buffer, int buffLen){
-    volatile int i = 0;
-
-    for(i = 0; (i < buffLen) && (*buffer != NULL_CHAR) ; i++){
-        dummyRXIFG = 0;
-        P6OUT &= ~SS_B1;     //assert SS
-        usciB1SpiPutChar(*buffer++);
-        //while ((UCB1IFG & UCRXIFG)); // poll RXIFG to know that the transmission ended
-        while(dummyRXIFG == 0);
-        P6OUT |= SS_B1;       //de-assert SS immediately after the last byte has been transmitted
-    }
-
-    //usciB1SpiPutChar('\n');             // move terminal to next line
-    return i;
-}
-
-//---- atoi on each byte in rxString and store in buffer
-void numStringToInt(char* rxString, int* rxBuffer){
-    volatile int i;
-    for(i = 0; rxString[i] != NULL_CHAR ; i++){
-        rxBuffer[i] = (int)(rxString[i]) - 48;
-    }
-}
-
-
-#pragma vector=USCI_B1_VECTOR
-__interrupt void usciB1SpiIsr(void) {
-	
-// UCB1IV interrupt handler. __even_in_range will optimize the C code so efficient jumps are implemented.
-  switch(__even_in_range(UCB1IV,4)) // this will clear the current highest priority flag. TXIFG or RXIFG.
-  {
-  	  case 0: break;                          	// Vector 0 - no interrupt
-  	  case 2:                                 	// Vector 2 - RXIFG. Highest priority
-		// process RXIFG
-  		spiRxBuffer[rxIdx] = UCB1RXBUF;
-  		rxIdx++;
-  		dummyRXIFG = 1;
-  		  break;
-
-  	  case 4:									// Vector 4 - TXIFG
-  		
-		// process TXIFG (careful)
-		
-  		  break;
-
-  	  default: break; 
-  }
-}
+/*
+ * usciSpi.c
+ *
+ * create a proper file header for the C module
+ */
+
+#include <msp430.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "usciSpi.h"
+#include "usciUart.h"
+#include "timerB0.h"
+#include "ucsClock.h"
+
+unsigned char spiRxBuffer[BUFFER_SZ] = {};
+static unsigned int rxIdx = 0;
+
+static unsigned int dummyRXIFG = 0;
+
+static unsigned int spiSclkDiv = 1;     // last divider passed to usciB1SpiClkDiv. sets the SCLK ceiling for the trace report
+
+#if SPI_TRACE_ENABLE
+static SPI_TRACE_ENTRY spiTrace[SPI_TRACE_SZ];    // circular. spiTraceHead is the next entry to write
+static unsigned int spiTraceHead = 0;
+static unsigned int spiTraceCount = 0;
+static unsigned long spiTraceLast = 0;            // timestamp of the previous entry
+#endif
+
+
+// create a function header that describes the function and how to use it. Provide an example function call.
+void usciB1SpiInit(unsigned char spiMST, unsigned int sclkDiv, unsigned char sclkMode, unsigned char spiLoopBack){
+	
+	// call usciB1SpiClkDiv
+	usciB1SpiClkDiv(sclkDiv);
+
+    UCB1CTL1 |= UCSWRST;                        // **Put state machine in USCI reset while you intitialize it**
+
+	// configure the control registers using the input arguments. See user manual, lecture notes and programmers model
+	UCB1CTL0 |= (sclkMode << 6)      // set clock mode sclkMode.1 = UCCKPH, sclkMode.0 = UCCKPL
+	         + (spiMST << 3)        // 0 = slave, 1 = master
+	         + UCMSB
+	         + UCSYNC;              // Sync == 1, SPI mode
+
+	UCB1CTL1 |= UCSSEL__SMCLK;
+	
+	if(spiLoopBack)
+	    UCB1STAT = UCLISTEN;
+
+	// configure the SPI B1 pins with PxSEL register
+	P4SEL |= SIMO_B1 + SCLK_B1;
+
+	// configure P6.0 to be output (SS)
+	P6DIR |= SS_B1;     // set P6.0 as output
+	P6OUT |= SS_B1;     // set it high (de-asserted)
+
+	UCB1CTL1 &= ~UCSWRST;                     	// **Initialize USCI state machine**  take it out of reset
+}
+
+
+// provide function header
+// this function is complete. Understand what it is doing.  Call it when SCLKDIV needs to be changed in Lab.
+void usciB1SpiClkDiv(unsigned int sclkDiv){
+
+    UCB1CTL1 |= UCSWRST;                        // you always need to put state machine into reset when configuring USC module
+
+    spiSclkDiv = sclkDiv ? sclkDiv : 1;         // BR = 0 behaves as /1
+
+    UCB1BR0 = (sclkDiv&0xFF);                   // 2
+    UCB1BR1 = (sclkDiv>>8);                     //
+
+    UCB1CTL1 &= ~UCSWRST;                       // **Initialize USCI state machine**
+}
+
+/************************************************************************************
+* Function: usciB1SpiSetFreq
+* - sets the SCLK divider for the fastest SCLK that does not exceed sclkHz at the current
+*   SMCLK (see ucsClockSmclkHz). Call again whenever SMCLK changes.
+*   ex: usciB1SpiSetFreq(4000000);  // 4 MHz max for the PCD8544
+* arguments:
+*   sclkHz - highest SCLK frequency the slave accepts
+* return: actual SCLK frequency in Hz
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned long usciB1SpiSetFreq(unsigned long sclkHz){
+    unsigned long smclkHz = ucsClockSmclkHz();
+    unsigned long div = (smclkHz + sclkHz - 1) / sclkHz;     // round up so SCLK <= sclkHz
+
+    if (div == 0)
+        div = 1;
+    if (div > 0xFFFF)
+        div = 0xFFFF;
+    usciB1SpiClkDiv((unsigned int)div);
+
+    return usciB1SpiSclkHz();
+}
+
+/************************************************************************************
+* Function: usciB1SpiSclkHz
+* - SCLK frequency produced by the current divider and SMCLK
+* arguments: none
+* return: SCLK in Hz
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned long usciB1SpiSclkHz(void){
+    return ucsClockSmclkHz() / spiSclkDiv;
+}
+
+// when the TXBUFFER is ready load it.    txByte-->TXBUFFER
+// provide a function header
+void usciB1SpiPutChar(char txByte) {
+    while (!(UCB1IFG & UCTXIFG)); // is this efficient ?
+    UCB1TXBUF = txByte;  // if TXBUFF ready then transmit a byte by writing to it
+}
+
+int usciB1SpiTxBuffer(int* buffer, int buffLen){
+    volatile int i = 0;
+
+    for(i = 0; (i < buffLen) && (*buffer != NULL_CHAR) ; i++){
+        dummyRXIFG = 0;
+        P6OUT &= ~SS_B1;     //assert SS
+        usciB1SpiPutChar(*buffer++);
+        //while ((UCB1IFG & UCRXIFG)); // poll RXIFG to know that the transmission ended
+        while(dummyRXIFG == 0);
+        P6OUT |= SS_B1;       //de-assert SS immediately after the last byte has been transmitted
+    }
+
+    //usciB1SpiPutChar('\n');             // move terminal to next line
+    return i;
+}
+
+//---- atoi on each byte in rxString and store in buffer
+void numStringToInt(char* rxString, int* rxBuffer){
+    volatile int i;
+    for(i = 0; rxString[i] != NULL_CHAR ; i++){
+        rxBuffer[i] = (int)(rxString[i]) - 48;
+    }
+}
+
+#if SPI_TRACE_ENABLE
+
+/************************************************************************************
+* Function: usciB1SpiTraceRecord
+* - appends one byte to the bus trace. Call right before the byte is loaded into TXBUF.
+*   the oldest entry is overwritten once the buffer is full.
+* arguments:
+*   txByte - byte about to be transmitted
+*   flags  - SPI_TRACE_DC, SPI_TRACE_CS_LOW, SPI_TRACE_CS_HIGH
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void usciB1SpiTraceRecord(unsigned char txByte, unsigned char flags){
+    unsigned long now = timerB0Now();
+    unsigned long dt = now - spiTraceLast;
+    SPI_TRACE_ENTRY* e = &spiTrace[spiTraceHead];
+
+    e->dt = (dt > 0xFFFF || spiTraceCount == 0) ? 0xFFFF : (unsigned int)dt;
+    e->txByte = txByte;
+    e->flags = flags;
+
+    spiTraceLast = now;
+    spiTraceHead = (spiTraceHead + 1) % SPI_TRACE_SZ;
+    if (spiTraceCount < SPI_TRACE_SZ)
+        spiTraceCount++;
+}
+
+/************************************************************************************
+* Function: usciB1SpiTraceCsHigh
+* - flags the most recent entry as the last byte before SCE' was released. used by burst
+*   writes that only know a byte was the last one after it has been sent.
+* arguments: none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void usciB1SpiTraceCsHigh(void){
+    if (spiTraceCount)
+        spiTrace[(spiTraceHead + SPI_TRACE_SZ - 1) % SPI_TRACE_SZ].flags |= SPI_TRACE_CS_HIGH;
+}
+
+/************************************************************************************
+* Function: usciB1SpiTraceReset
+* - empties the trace buffer
+* arguments: none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void usciB1SpiTraceReset(void){
+    spiTraceHead = 0;
+    spiTraceCount = 0;
+}
+
+/************************************************************************************
+* Function: usciB1SpiTraceDump
+* - exports the trace over UART A1, oldest entry first, one entry per line:
+*   <dt ticks> <C|D> <byte hex> <cs flags: L = asserted before, H = released after>
+* arguments: none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void usciB1SpiTraceDump(void){
+    char line[24];
+    const SPI_TRACE_ENTRY* e;
+    unsigned int i;
+    unsigned int idx = (spiTraceHead + SPI_TRACE_SZ - spiTraceCount) % SPI_TRACE_SZ;
+
+    for (i = 0; i < spiTraceCount; i++){
+        e = &spiTrace[idx];
+        sprintf(line, "%u %c %02X %c%c\r\n", e->dt,
+                (e->flags & SPI_TRACE_DC) ? 'D' : 'C', e->txByte,
+                (e->flags & SPI_TRACE_CS_LOW) ? 'L' : '-',
+                (e->flags & SPI_TRACE_CS_HIGH) ? 'H' : '-');
+        usciA1UartTxString(line);
+        idx = (idx + 1) % SPI_TRACE_SZ;
+    }
+}
+
+/************************************************************************************
+* Function: usciB1SpiTraceReport
+* - analyses the trace and prints over UART A1:
+*   achieved bytes/s while the bus is active vs the SCLK ceiling (SMCLK / sclkDiv / 8),
+*   average inter-byte gap beyond the 8 SCLK byte time, number of idle periods,
+*   command/data byte mix and number of SCE' edges.
+*   gaps longer than SPI_TRACE_IDLE_TICKS count as idle time and are excluded from the
+*   active window.
+* arguments: none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void usciB1SpiTraceReport(void){
+    char line[80];
+    const SPI_TRACE_ENTRY* e;
+    unsigned long activeTicks = 0;      // sum of inter-byte deltas within bursts
+    unsigned long byteTicks = 8UL * spiSclkDiv / TIMERB0_DIV;     // 8 SCLKs in TB0 ticks
+    unsigned long gapTicks = 0;
+    unsigned int nGaps = 0, nIdle = 0, nCmd = 0, nCs = 0;
+    unsigned int i;
+    unsigned int idx = (spiTraceHead + SPI_TRACE_SZ - spiTraceCount) % SPI_TRACE_SZ;
+
+    for (i = 0; i < spiTraceCount; i++){
+        e = &spiTrace[idx];
+        if (!(e->flags & SPI_TRACE_DC))
+            nCmd++;
+        if (e->flags & SPI_TRACE_CS_LOW)
+            nCs++;
+        if (e->flags & SPI_TRACE_CS_HIGH)
+            nCs++;
+        if (i != 0){
+            if (e->dt > SPI_TRACE_IDLE_TICKS)
+                nIdle++;
+            else {
+                activeTicks += e->dt;
+                nGaps++;
+            }
+        }
+        idx = (idx + 1) % SPI_TRACE_SZ;
+    }
+
+    sprintf(line, "bytes %u cmd %u dat %u cs edges %u idle %u\r\n",
+            spiTraceCount, nCmd, spiTraceCount - nCmd, nCs, nIdle);
+    usciA1UartTxString(line);
+
+    // deltas measure byte start to byte start, so the gap is whatever exceeds the 8 SCLK byte time
+    if (nGaps){
+        gapTicks = activeTicks / nGaps;
+        gapTicks = (gapTicks > byteTicks) ? gapTicks - byteTicks : 0;
+    }
+
+    // each burst also pays for its final byte time. nGaps + nIdle + 1 == spiTraceCount
+    if (spiTraceCount){
+        activeTicks += (unsigned long)(nIdle + 1) * byteTicks;
+        sprintf(line, "achieved %lu B/s ceiling %lu B/s gap %lu us\r\n",
+                (unsigned long)(((unsigned long long)spiTraceCount * TIMERB0_CLK_HZ) / activeTicks),
+                TIMERB0_CLK_HZ / byteTicks,
+                timerB0TicksToUs(gapTicks));
+        usciA1UartTxString(line);
+    }
+}
+
+#else
+
+void usciB1SpiTraceRecord(unsigned char txByte, unsigned char flags){
+    (void)txByte;
+    (void)flags;
+}
+
+void usciB1SpiTraceCsHigh(void){
+}
+
+void usciB1SpiTraceReset(void){
+}
+
+void usciB1SpiTraceDump(void){
+    usciA1UartTxString("SPI trace disabled. Build with SPI_TRACE_ENABLE = 1.\r\n");
+}
+
+void usciB1SpiTraceReport(void){
+    usciB1SpiTraceDump();
+}
+
+#endif /* SPI_TRACE_ENABLE */
+
+#pragma vector=USCI_B1_VECTOR
+__interrupt void usciB1SpiIsr(void) {
+	
+// UCB1IV interrupt handler. __even_in_range will optimize the C code so efficient jumps are implemented.
+  switch(__even_in_range(UCB1IV,4)) // this will clear the current highest priority flag. TXIFG or RXIFG.
+  {
+  	  case 0: break;                          	// Vector 0 - no interrupt
+  	  case 2:                                 	// Vector 2 - RXIFG. Highest priority
+		// process RXIFG
+  		spiRxBuffer[rxIdx] = UCB1RXBUF;
+  		rxIdx++;
+  		dummyRXIFG = 1;
+  		  break;
+
+  	  case 4:									// Vector 4 - TXIFG
+  		
+		// process TXIFG (careful)
+		
+  		  break;
+
+  	  default: break; 
+  }
+}
@@ -1,34 +1,63 @@
-/*
- * usciSpi.h
- *
- *  Created on: Mar 2, 2021
- *      Author: Raymond
- */
-
-#ifndef USCISPI_H_
-#define USCISPI_H_
-
-#define SIMO_B1 BIT1
-#define SOMI_B1 BIT2
-#define SCLK_B1 BIT3
-
-#define SS_B1   BIT0
-
-#define BUFFER_SZ 100
-
-//------
-
-void usciB1SpiInit(unsigned char spiMST, unsigned int sclkDiv, unsigned char sclkMode, unsigned char spiLoopBack);
-void usciB1SpiClkDiv(unsigned int sclkDiv);
-void usciB1SpiPutChar(char txByte);
-int usciB1SpiTxBuffer(int* buffer, int buffLen);
-void numStringToInt(char* rxString, int* rxBuffer);
-
-unsigned char spiRxBuffer[BUFFER_SZ] = {};
-static unsigned int rxIdx = 0;
-
-static unsigned int dummyRXIFG = 0;
-
-
-
-#endif /* USCISPI_H_ */
+/*
+ * usciSpi.h
+ *
+ *  Created on: Mar 2, 2021
+ *      Author: Raymond
+ */
+
+#ifndef USCISPI_H_
+#define USCISPI_H_
+
+#define SIMO_B1 BIT1
+#define SOMI_B1 BIT2
+#define SCLK_B1 BIT3
+
+#define SS_B1   BIT0
+
+#define BUFFER_SZ 100
+
+// optional bus trace. set SPI_TRACE_ENABLE to 1 here or in the project predefined symbols
+#ifndef SPI_TRACE_ENABLE
+#define SPI_TRACE_ENABLE 0
+#endif
+
+#define SPI_TRACE_SZ        128         // entries in the circular trace buffer (4 bytes each)
+#define SPI_TRACE_DC        BIT0        // byte was data (D/C' high)
+#define SPI_TRACE_CS_LOW    BIT1        // SCE' was asserted right before this byte
+#define SPI_TRACE_CS_HIGH   BIT2        // SCE' was released right after this byte
+#define SPI_TRACE_IDLE_TICKS 2048       // TB0 ticks (1 ms at 16 MHz). longer gaps count as bus idle, not inter-byte gap
+
+#if SPI_TRACE_ENABLE
+#define SPI_TRACE(txByte, flags)    usciB1SpiTraceRecord((txByte), (flags))
+#define SPI_TRACE_CS_RELEASE()      usciB1SpiTraceCsHigh()
+#else
+#define SPI_TRACE(txByte, flags)    do {} while (0)     // still a statement, e.g. as an else body
+#define SPI_TRACE_CS_RELEASE()      do {} while (0)
+#endif
+
+typedef struct SPI_TRACE_ENTRY {
+    unsigned int dt;                    // TB0 ticks since the previous entry, saturated at 0xFFFF
+    unsigned char txByte;
+    unsigned char flags;                // SPI_TRACE_xxx
+}SPI_TRACE_ENTRY;
+
+//------
+
+void usciB1SpiInit(unsigned char spiMST, unsigned int sclkDiv, unsigned char sclkMode, unsigned char spiLoopBack);
+void usciB1SpiClkDiv(unsigned int sclkDiv);
+unsigned long usciB1SpiSetFreq(unsigned long sclkHz);
+unsigned long usciB1SpiSclkHz(void);
+void usciB1SpiPutChar(char txByte);
+int usciB1SpiTxBuffer(int* buffer, int buffLen);
+void numStringToInt(char* rxString, int* rxBuffer);
+void usciB1SpiTraceRecord(unsigned char txByte, unsigned char flags);
+void usciB1SpiTraceCsHigh(void);
+void usciB1SpiTraceReset(void);
+void usciB1SpiTraceDump(void);
+void usciB1SpiTraceReport(void);
+
+extern unsigned char spiRxBuffer[BUFFER_SZ];   // defined in usciSpi.c. one copy however many files include this
+
+
+
+#endif /* USCISPI_H_ */
@@ -1,148 +1,328 @@
-/*************************************************************************************************
- * usciUart.c
- * - C implementation or source file for MSP430 usci UART A1
- *
- *  Author: Greg Scutt
- *  Created on: March 1, 2017
- *  Modified: February 26th, 2018
- **************************************************************************************************/
-
-#include <msp430.h>
-#include <string.h>
-#include <stdio.h>
-
-#include "usciUart.h"
-#include "usciSpi.h"
-
-/************************************************************************************
-* Function: usciA1UartInit
-* - configures UCA1 UART to use SMCLK, no parity, 8 bit data, LSB first, one stop bit
-*  BAUD rate = 19.2Kbps with 16xoversampling.
-*  assumes SMCLK = 2^20 Hz.
-* argument:
-* Arguments: none, but baud rate would be useful
-*
-* return: none
-* Author: Greg Scutt
-* Date: March 1st, 2017
-* Modified: <date of any mods> usually taken care of by rev control
-************************************************************************************/
-void usciA1UartInit(){
-
-	// READ THIS --> You must use usci Control BITS defined in msp430.h !!
-	// In fact you must use pre-defined control bits whenever possible. no obscure HEX codes allowed anymore.
-
-	P4SEL |= TXD_A1 | RXD_A1;
-	UCA1CTL1 |= UCSWRST; 			// USCI A1  Software Reset Enabled
-	//********************
-
-	UCA1CTL1 	|= 	UCSSEL_2; 		// select SMCLK. User is responsible for setting this rate.
-
-	UCA1CTL0	= 	0; 				// RESET UCA1CTL0 before new configuration
-	UCA1CTL0	&=	~UCPEN			// No Parity
-				&	~UCMSB			// LSB First
-				&	~UC7BIT			// 8 bits of data
-				&	~UCSPB			// 1 stop bit
-				&	~UCSYNC;		// UART Mode
-
-
-	UCA1BR0 = 0x03; // calculate and confirm with table
-	UCA1MCTL = UCBRF_6 + UCBRS1 + UCOS16; // calculate and confirm with table.
-
-
-	UCA1CTL1 	&= ~UCSWRST; 		//  configured. take state machine out of reset.
-	}
-
-
-/************************************************************************************
-* Function: usciA1UartTxChar
-* - writes a single character to UCA1TXBUF if it is ready
-* argument:
-* Arguments: txChar - byte to be transmitted
-*
-* return: none
-* Author: Greg Scutt
-* Date: March 1st, 2017
-* Modified: <date of any mods> usually taken care of by rev control
-************************************************************************************/
-void usciA1UartTxChar(char txChar) {
-
-	while (!(UCA1IFG & UCTXIFG)); // is this efficient ?
-		UCA1TXBUF = txChar;	 // if TXBUFF ready then transmit a byte by writing to it
-}
-
-
-/************************************************************************************
-* Function: usciA1UartTxString
-* - writes a C string of characters, one char at a time to UCA1TXBUF by calling
-*   usciA1UartTxChar. Stops when it encounters  the NULL character in the string
-*   does NOT transmit the NULL character
-*
-* Arguments: txChar - pointer to char (string) to be transmitted
-*
-* return: number of characters transmitted
-* Author: Greg Scutt
-* Date: March 1st, 2017
-* Modified: <date of any mods> usually taken care of by rev control
-************************************************************************************/
-void usciA1UartTxString(char *txChar){
-    while(*txChar != NULL_CHAR)        // while not a null character
-        usciA1UartTxChar(*txChar++);    // transmit a character with usciA1UartTxChar and increment the pointer
-	}
-
-int usciA1UartTxBuffer(char* buffer, int buffLen){
-    volatile int i = 0;
-
-    for(i = 0; (i < buffLen) && (*buffer != NULL_CHAR) ; i++){
-            usciA1UartTxChar(*buffer++);
-    }
-    usciA1UartTxChar('\n');             // move terminal to next line
-    return i;
-}
-//TEST
-/************************************************************************************
-* Function: usciA1UartTxString
-* - writes a C string of characters, one char at a time to UCA1TXBUF by calling
-*   usciA1UartTxChar. Stops when it encounters  the NULL character in the string
-*   does NOT transmit the NULL character
-*
-* Arguments: txChar - pointer to char (string) to be transmitted
-*
-* return: number of characters transmitted
-* Author: Greg Scutt
-* Date: March 1st, 2017
-* Modified: <date of any mods> usually taken care of by rev control
-************************************************************************************/
-char* usciA1UartGets(char* rxString){
-    unsigned int i = 0;
-
-    do{
-       while(!(UCA1IFG & UCRXIFG));     // check if RX is ready
-       rxBuffer[i++] = UCA1RXBUF;       // store received byte
-       usciA1UartTxChar(UCA1RXBUF);     // echo it back through TX
-    }while((UCA1RXBUF != NL_CHAR) && (i < BUFF_SZ));    // loop while user hasnt pressed enter and buffer isnt full
-
-    rxBuffer[i-1] = NULL_CHAR;            // insert NULL into string
-    strcpy(rxString,rxBuffer);          //
-    usciA1UartTxChar('\n');             // move terminal to next line
-
-    return rxString;
-}
-
-#pragma vector = USCI_A1_VECTOR
-__interrupt void USCI_A1_ISR(void) {
-  switch(__even_in_range(UCA1IV,4))
-  {
-  case 0:break;
-  case 2:
-      usciB1SpiPutChar(UCA1RXBUF);
-      // 5.6.1
-//      if(UCTXIFG)
-//	   UCA1TXBUF = UCA1RXBUF;
-    break;
-  case 4:break;
-  default: break;
-  }
-}
-
-
+/*************************************************************************************************
+ * usciUart.c
+ * - C implementation or source file for MSP430 usci UART A1
+ *
+ *  Author: Greg Scutt
+ *  Created on: March 1, 2017
+ *  Modified: February 26th, 2018
+ **************************************************************************************************/
+
+#include <msp430.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "usciUart.h"
+#include "usciSpi.h"
+#include "ucsClock.h"
+#include "events.h"
+
+// TX ring. two producers fill it at the head, usciA1UartTxChar and the RX ISR echo, so the head is
+// only moved with interrupts off. the TX ISR is the only consumer (tail)
+static volatile unsigned char txRing[UART_TX_RING_SZ];
+static volatile unsigned int txHead = 0;
+static volatile unsigned int txTail = 0;
+static unsigned int txDropped = 0;
+
+// RX line queue. the RX ISR assembles into rxLines[rxLineHead] and advances rxLineHead on enter,
+// usciA1UartLineGet copies out rxLines[rxLineTail]. free running indexes, one writer each
+static char rxLines[UART_RX_LINES][BUFF_SZ];
+static volatile unsigned char rxLineHead = 0;
+static volatile unsigned char rxLineTail = 0;
+static unsigned int rxIdxA1 = 0;
+static unsigned int rxDropped = 0;
+
+/************************************************************************************
+* Function: usciA1UartInit
+* - configures UCA1 UART to use SMCLK, no parity, 8 bit data, LSB first, one stop bit
+*  BAUD rate = UART_BAUD. dividers are computed from the current SMCLK (ucsClockSmclkHz)
+*  so call it after ucsClockInit.
+* argument:
+* Arguments: none, but baud rate would be useful
+*
+* return: none
+* Author: Greg Scutt
+* Date: March 1st, 2017
+* Modified: Oct 19th, 2026 - Marcus Kuhn. baud dividers computed at runtime
+************************************************************************************/
+void usciA1UartInit(){
+
+	// READ THIS --> You must use usci Control BITS defined in msp430.h !!
+	// In fact you must use pre-defined control bits whenever possible. no obscure HEX codes allowed anymore.
+
+	P4SEL |= TXD_A1 | RXD_A1;
+	UCA1CTL1 |= UCSWRST; 			// USCI A1  Software Reset Enabled
+	//********************
+
+	UCA1CTL1 	|= 	UCSSEL_2; 		// select SMCLK. User is responsible for setting this rate.
+
+	UCA1CTL0	= 	0; 				// RESET UCA1CTL0 before new configuration
+	UCA1CTL0	&=	~UCPEN			// No Parity
+				&	~UCMSB			// LSB First
+				&	~UC7BIT			// 8 bits of data
+				&	~UCSPB			// 1 stop bit
+				&	~UCSYNC;		// UART Mode
+
+
+	usciA1UartSetBaud(UART_BAUD);	// BR and modulation for the current SMCLK. takes the state machine out of reset
+
+	UCA1IE |= UCRXIE;				// lines are assembled in the RX ISR. GIE is set by the caller
+	}
+
+/************************************************************************************
+* Function: usciA1UartSetBaud
+* - reprograms UCA1BRx and UCA1MCTL for baud at the current SMCLK using ucsBaudCalc.
+*   wait for pending output (usciA1UartFlush) before changing the rate.
+* argument:
+* Arguments: baud - baud rate, ex: usciA1UartSetBaud(115200);
+*
+* return: 0 - configured, -1 - rate not reachable at this SMCLK (settings unchanged)
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int usciA1UartSetBaud(unsigned long baud){
+	UART_BAUD_CFG cfg;
+	unsigned char ie = UCA1IE;		// UCSWRST clears the interrupt enables. put them back after
+
+	if (ucsBaudCalc(ucsClockSmclkHz(), baud, &cfg))
+		return -1;
+
+	UCA1CTL1 |= UCSWRST;			// hold the state machine in reset while the dividers change
+	UCA1BR0 = cfg.br & 0xFF;
+	UCA1BR1 = cfg.br >> 8;
+	UCA1MCTL = (cfg.brf * UCBRF0) + (cfg.brs * UCBRS0) + (cfg.os16 ? UCOS16 : 0);
+	UCA1CTL1 &= ~UCSWRST; 			// configured. take state machine out of reset.
+	UCA1IE = ie;
+
+	return 0;
+}
+
+
+/************************************************************************************
+* Function: usciA1UartTxPut
+* - puts a character in the TX ring if there is room and enables the TX interrupt to drain
+*   it. Never waits. Call with interrupts off: the RX ISR echo also fills the ring.
+* argument:
+*   txChar - byte to be transmitted
+* return: 1 - queued, 0 - ring full
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+static int usciA1UartTxPut(char txChar) {
+    unsigned int next = (txHead + 1) & UART_TX_RING_MASK;
+
+    if (next == txTail)
+        return 0;
+    txRing[txHead] = txChar;
+    txHead = next;
+    UCA1IE |= UCTXIE;                           // TXIFG is set whenever TXBUF is empty, so this starts the drain
+    return 1;
+}
+
+/************************************************************************************
+* Function: usciA1UartTxChar
+* - queues a single character in the TX ring and enables the TX interrupt to drain it.
+*   does not wait for the character to go out. When the ring is full the
+*   UART_TX_OVF_POLICY decides: BLOCK waits for space, DROP discards and counts.
+*   The enqueue runs with interrupts off; BLOCK opens them again while it waits so the
+*   TX ISR can make room. With GIE clear on entry BLOCK pushes the oldest char out by
+*   polling instead of waiting on the interrupt, so it never deadlocks.
+* argument:
+* Arguments: txChar - byte to be transmitted
+*
+* return: none
+* Author: Greg Scutt
+* Date: March 1st, 2017
+* Modified: Oct 19th, 2026 - Marcus Kuhn. enqueue into the TX ring with interrupts off
+************************************************************************************/
+void usciA1UartTxChar(char txChar) {
+    unsigned short state = __get_interrupt_state();
+
+    __disable_interrupt();                      // the RX ISR echo must not move the head under us
+    while (!usciA1UartTxPut(txChar)){           // ring full
+#if UART_TX_OVF_POLICY == UART_TX_OVF_DROP
+        txDropped++;
+        break;
+#else
+        __set_interrupt_state(state);           // if GIE was set the TX ISR makes room while we wait
+        if (!(__get_SR_register() & GIE) && (UCA1IFG & UCTXIFG)){  // ISR cannot run. drain one char by hand
+            UCA1TXBUF = txRing[txTail];
+            txTail = (txTail + 1) & UART_TX_RING_MASK;
+        }
+        __disable_interrupt();
+#endif
+    }
+    __set_interrupt_state(state);
+}
+
+/************************************************************************************
+* Function: usciA1UartFlush
+* - waits until every queued character has been shifted out of the UART
+* argument:
+*   none
+* return: none
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void usciA1UartFlush(void) {
+    while (txHead != txTail){
+        if (!(__get_SR_register() & GIE) && (UCA1IFG & UCTXIFG)){  // no interrupts. drain by polling
+            UCA1TXBUF = txRing[txTail];
+            txTail = (txTail + 1) & UART_TX_RING_MASK;
+        }
+    }
+    while (UCA1STAT & UCBUSY);                  // last char still in the shift register
+}
+
+/************************************************************************************
+* Function: usciA1UartTxDropped
+* - number of characters discarded by the DROP overflow policy, plus echoes the RX ISR
+*   found no room for (it never waits on a full ring)
+* argument:
+*   none
+* return: dropped character count
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned int usciA1UartTxDropped(void) {
+    return txDropped;
+}
+
+
+/************************************************************************************
+* Function: usciA1UartTxString
+* - writes a C string of characters, one char at a time to UCA1TXBUF by calling
+*   usciA1UartTxChar. Stops when it encounters  the NULL character in the string
+*   does NOT transmit the NULL character
+*
+* Arguments: txChar - pointer to char (string) to be transmitted
+*
+* return: number of characters transmitted
+* Author: Greg Scutt
+* Date: March 1st, 2017
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+void usciA1UartTxString(char *txChar){
+    while(*txChar != NULL_CHAR)        // while not a null character
+        usciA1UartTxChar(*txChar++);    // transmit a character with usciA1UartTxChar and increment the pointer
+	}
+
+int usciA1UartTxBuffer(char* buffer, int buffLen){
+    volatile int i = 0;
+
+    for(i = 0; (i < buffLen) && (*buffer != NULL_CHAR) ; i++){
+            usciA1UartTxChar(*buffer++);
+    }
+    usciA1UartTxChar('\n');             // move terminal to next line
+    return i;
+}
+//TEST
+/************************************************************************************
+* Function: usciA1UartGets
+* - returns the next line typed on the terminal. The line is assembled and echoed by the
+*   RX ISR; this sleeps in LPM0 (eventWait) until enter is pressed, then copies it out.
+*   The enter key is replaced by the NULL character.
+*
+* Arguments: rxString - destination, at least BUFF_SZ chars
+*
+* return: rxString
+* Author: Greg Scutt
+* Date: March 1st, 2017
+* Modified: Oct 19th, 2026 - Marcus Kuhn. line assembled in the RX ISR, sleeps while waiting
+************************************************************************************/
+char* usciA1UartGets(char* rxString){
+    while (!usciA1UartLineGet(rxString))
+        eventWait(EVT_UART_LINE);       // LPM0 until the RX ISR sees enter
+
+    return rxString;
+}
+
+/************************************************************************************
+* Function: usciA1UartLinesPending
+* - number of complete lines waiting in the RX line queue
+* Arguments: none
+* return: 0 to UART_RX_LINES
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned int usciA1UartLinesPending(void){
+    return (unsigned char)(rxLineHead - rxLineTail);
+}
+
+/************************************************************************************
+* Function: usciA1UartLineGet
+* - takes the oldest complete line out of the RX line queue without waiting. freeing the
+*   slot lets the RX ISR accept characters again if the queue was full.
+* Arguments: rxString - destination, at least BUFF_SZ chars
+* return: 1 if a line was copied, 0 if the queue was empty
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+int usciA1UartLineGet(char* rxString){
+    if (rxLineHead == rxLineTail)
+        return 0;
+
+    strcpy(rxString, rxLines[rxLineTail & UART_RX_LINES_MASK]);
+    rxLineTail++;                       // RX ISR may reuse the slot
+    return 1;
+}
+
+/************************************************************************************
+* Function: usciA1UartRxDropped
+* - number of received chars dropped because the RX line queue was full
+* Arguments: none
+* return: dropped char count since power up
+* Author: Marcus Kuhn
+* Date: Oct 19th, 2026
+* Modified: <date of any mods> usually taken care of by rev control
+************************************************************************************/
+unsigned int usciA1UartRxDropped(void){
+    return rxDropped;
+}
+
+#pragma vector = USCI_A1_VECTOR
+__interrupt void USCI_A1_ISR(void) {
+  char rxChar;
+
+  switch(__even_in_range(UCA1IV,4))
+  {
+  case 0:break;
+  case 2:                                      // RXIFG. build the line, echo as it is typed
+      rxChar = UCA1RXBUF;
+      if ((unsigned char)(rxLineHead - rxLineTail) == UART_RX_LINES){
+          rxDropped++;                          // every slot holds an uncollected line. no echo so the loss shows
+          break;
+      }
+      if (!usciA1UartTxPut(rxChar))             // echo it back through TX. interrupts are off in here
+          txDropped++;                          // ring full: the echo is lost, the line is not
+      if (rxChar == NL_CHAR || rxIdxA1 == BUFF_SZ - 1){
+          rxLines[rxLineHead & UART_RX_LINES_MASK][rxIdxA1] = NULL_CHAR;  // insert NULL into string
+          rxIdxA1 = 0;
+          rxLineHead++;                         // line complete. hand it over
+          if (!usciA1UartTxPut('\n'))           // move terminal to next line
+              txDropped++;
+          EVENT_POST_FROM_ISR(EVT_UART_LINE);
+      }
+      else
+          rxLines[rxLineHead & UART_RX_LINES_MASK][rxIdxA1++] = rxChar;  // store received byte
+    break;
+  case 4:                                      // TXIFG. TXBUF is empty
+      if (txTail != txHead){
+          UCA1TXBUF = txRing[txTail];
+          txTail = (txTail + 1) & UART_TX_RING_MASK;
+      }
+      else{
+          UCA1IE &= ~UCTXIE;                    // ring empty. re-enabled by the next usciA1UartTxChar
+          UCA1IFG |= UCTXIFG;                   // reading UCA1IV cleared it, but TXBUF is still empty
+      }
+      break;
+  default: break;
+  }
+}
+
+
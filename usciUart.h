@@ -1,35 +1,59 @@
-/*************************************************************************************************
- * usciUart.h
- * - C interface file for MSP430 usci UART A1, A0
- *
- *  Author: Greg Scutt
- *  Created on: March 1, 2017
- *  Modified: Feb 19, 2018
- **************************************************************************************************/
-
-#ifndef USCIUART_H_
-#define USCIUART_H_
-
-#define     _UART_A1PSEL    P4SEL |= PM_UCA1TXD | PM_UCA1RXD // use macros for short expressions.
-
-#define     TXD_A1          BIT4            //Transmit Data on P4.4
-#define     RXD_A1          BIT5            //Recieve Data on P4.5
-#define     NULL_CHAR       '\0'          // null char
-#define     NL_CHAR         0x0D          // new line char
-#define     BUFF_SZ         100
-#define     PER_DELAY       168000  // 80 ms delay
-
-void usciA1UartInit();
-
-void usciA1UartTxChar(char txChar);
-
-void usciA1UartTxString(char* txChar);
-
-int usciA1UartTxBuffer(char* buffer, int buffLen);
-
-char* usciA1UartGets(char* rxString);
-
-char rxBuffer[BUFF_SZ];
-
-
-#endif /* USCIUART_H_ */
+/*************************************************************************************************
+ * usciUart.h
+ * - C interface file for MSP430 usci UART A1, A0
+ *
+ *  Author: Greg Scutt
+ *  Created on: March 1, 2017
+ *  Modified: Feb 19, 2018
+ **************************************************************************************************/
+
+#ifndef USCIUART_H_
+#define USCIUART_H_
+
+#define     _UART_A1PSEL    P4SEL |= PM_UCA1TXD | PM_UCA1RXD // use macros for short expressions.
+
+#define     TXD_A1          BIT4            //Transmit Data on P4.4
+#define     RXD_A1          BIT5            //Recieve Data on P4.5
+#define     NULL_CHAR       '\0'          // null char
+#define     NL_CHAR         0x0D          // new line char
+#define     BUFF_SZ         100
+#define     PER_DELAY       168000  // 80 ms delay
+#define     UART_BAUD       19200   // baud used by usciA1UartInit. any rate ucsBaudCalc can reach
+
+// TX ring buffer drained by the USCI_A1 TX interrupt. GIE must be set for it to drain on its own.
+#define     UART_TX_RING_SZ     128     // must be a power of 2
+#define     UART_TX_RING_MASK   (UART_TX_RING_SZ - 1)
+#define     UART_TX_OVF_BLOCK   0       // full ring: wait for space (never loses output)
+#define     UART_TX_OVF_DROP    1       // full ring: discard the char and count it
+#ifndef     UART_TX_OVF_POLICY
+#define     UART_TX_OVF_POLICY  UART_TX_OVF_BLOCK
+#endif
+
+// RX line queue filled by the USCI_A1 RX interrupt. while it is full, received chars are dropped and counted
+#define     UART_RX_LINES       4       // must be a power of 2
+#define     UART_RX_LINES_MASK  (UART_RX_LINES - 1)
+
+void usciA1UartInit();
+
+int usciA1UartSetBaud(unsigned long baud);
+
+void usciA1UartTxChar(char txChar);
+
+void usciA1UartTxString(char* txChar);
+
+int usciA1UartTxBuffer(char* buffer, int buffLen);
+
+char* usciA1UartGets(char* rxString);
+
+unsigned int usciA1UartLinesPending(void);
+
+int usciA1UartLineGet(char* rxString);
+
+unsigned int usciA1UartRxDropped(void);
+
+void usciA1UartFlush(void);
+
+unsigned int usciA1UartTxDropped(void);
+
+
+#endif /* USCIUART_H_ */